@@ -2,10 +2,20 @@
 
 #include "Chess.h"
 
+#include "Board/ChessBitboard.h"
+#include "Board/ChessPieceSquareTables.h"
+#include "Board/ChessZobrist.h"
+
 #define LOCTEXT_NAMESPACE "FChessModule"
 
+DEFINE_LOG_CATEGORY(LogChess);
+
 void FChessModule::StartupModule()
 {
+	ChessBitboard::InitializeAttackTables();
+	ChessZobrist::InitializeKeys();
+	ChessPieceSquare::InitializeTables();
+
 	static const FName PropertyEditor("PropertyEditor");
 	FPropertyEditorModule& PropertyModule = FModuleManager::GetModuleChecked<FPropertyEditorModule>(PropertyEditor);
 
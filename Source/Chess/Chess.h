@@ -5,6 +5,11 @@
 #include "CoreMinimal.h"
 
 #include "Modules/ModuleManager.h"
+#include "Stats/Stats.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogChess, Log, All);
+
+DECLARE_STATS_GROUP(TEXT("Chess"), STATGROUP_Chess, STATCAT_Advanced);
 
 class FChessModule : public IModuleInterface
 {
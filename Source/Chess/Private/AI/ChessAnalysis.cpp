@@ -0,0 +1,52 @@
+// Copyright Kunal Patil (kroxyserver). All Rights Reserved.
+
+#include "AI/ChessAnalysis.h"
+
+FChessAnalysis::FChessAnalysis(const FChessPosition& InPosition, const FChessSearchLimits& InLimits, const TArray<uint64>& InGameHistory, TSharedPtr<FChessTranspositionTable, ESPMode::ThreadSafe> InTranspositionTable, TSharedPtr<const FChessNeuralNetwork, ESPMode::ThreadSafe> InNeuralNetwork) :
+	Position(InPosition),
+	Limits(InLimits),
+	GameHistory(InGameHistory),
+	TranspositionTable(MoveTemp(InTranspositionTable)),
+	NeuralNetwork(MoveTemp(InNeuralNetwork))
+{
+	Search.SetTranspositionTable(TranspositionTable.Get());
+	Search.SetNeuralNetwork(NeuralNetwork.Get());
+}
+
+void FChessAnalysis::Start()
+{
+	check(IsInGameThread());
+	check(!Task.IsValid());
+
+	if (TranspositionTable.IsValid()) TranspositionTable->NewSearch();
+
+	// Only the main search thread reports iterations, so this is the queue's one producer
+	Search.OnIterationComplete = [this](const FChessSearchResult& Result)
+	{
+		Results.Enqueue(Result);
+	};
+
+	Task = UE::Tasks::Launch(UE_SOURCE_LOCATION, [This = AsShared()]()
+	{
+		This->Search.Search(This->Position, This->Limits, This->GameHistory);
+	}, UE::Tasks::ETaskPriority::BackgroundNormal);
+}
+
+void FChessAnalysis::Stop()
+{
+	Search.RequestStop();
+}
+
+void FChessAnalysis::Wait()
+{
+	if (Task.IsValid()) Task.Wait();
+}
+
+bool FChessAnalysis::DrainLatest(FChessSearchResult& OutResult)
+{
+	bool bDrained = false;
+
+	while (Results.Dequeue(OutResult)) bDrained = true;
+
+	return bDrained;
+}
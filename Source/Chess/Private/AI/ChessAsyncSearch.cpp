@@ -0,0 +1,69 @@
+// Copyright Kunal Patil (kroxyserver). All Rights Reserved.
+
+#include "AI/ChessAsyncSearch.h"
+
+#include "Async/Async.h"
+
+FChessAsyncSearch::FChessAsyncSearch(const FChessPosition& InPosition, const FChessSearchLimits& InLimits, const TArray<uint64>& InGameHistory, TSharedPtr<FChessTranspositionTable, ESPMode::ThreadSafe> InTranspositionTable, TSharedPtr<const FChessNeuralNetwork, ESPMode::ThreadSafe> InNeuralNetwork) :
+	Position(InPosition),
+	Limits(InLimits),
+	GameHistory(InGameHistory),
+	TranspositionTable(MoveTemp(InTranspositionTable)),
+	NeuralNetwork(MoveTemp(InNeuralNetwork))
+{
+	Search.SetTranspositionTable(TranspositionTable.Get());
+	Search.SetNeuralNetwork(NeuralNetwork.Get());
+}
+
+void FChessAsyncSearch::Start(FOnChessSearchProgress InOnProgress, FOnChessSearchComplete InOnComplete)
+{
+	check(IsInGameThread());
+	check(!Task.IsValid());
+
+	OnProgress = MoveTemp(InOnProgress);
+	OnComplete = MoveTemp(InOnComplete);
+
+	if (TranspositionTable.IsValid()) TranspositionTable->NewSearch();
+
+	// Only ever called from inside Search, while the worker below keeps this object alive
+	Search.OnIterationComplete = [this](const FChessSearchResult& Result)
+	{
+		if (bCancelled.load(std::memory_order_relaxed)) return;
+
+		AsyncTask(ENamedThreads::GameThread, [This = AsShared(), Result]()
+		{
+			if (!This->bCancelled.load(std::memory_order_relaxed)) This->OnProgress.ExecuteIfBound(Result);
+		});
+	};
+
+	Task = UE::Tasks::Launch(UE_SOURCE_LOCATION, [This = AsShared()]()
+	{
+		const FChessSearchResult Result = This->Search.Search(This->Position, This->Limits, This->GameHistory);
+
+		AsyncTask(ENamedThreads::GameThread, [This, Result]()
+		{
+			if (!This->bCancelled.load(std::memory_order_relaxed)) This->OnComplete.ExecuteIfBound(Result);
+		});
+	}, UE::Tasks::ETaskPriority::BackgroundHigh);
+}
+
+void FChessAsyncSearch::Stop()
+{
+	Search.RequestStop();
+}
+
+void FChessAsyncSearch::Cancel()
+{
+	bCancelled.store(true, std::memory_order_relaxed);
+	Search.RequestStop();
+}
+
+void FChessAsyncSearch::PonderHit()
+{
+	Search.PonderHit();
+}
+
+void FChessAsyncSearch::Wait()
+{
+	if (Task.IsValid()) Task.Wait();
+}
@@ -0,0 +1,252 @@
+// Copyright Kunal Patil (kroxyserver). All Rights Reserved.
+
+#include "AI/ChessEvaluation.h"
+
+#include "Board/ChessPosition.h"
+
+namespace
+{
+	// Indexed by EChessPiece::Type, squares reachable beyond the offset earn the weight, fewer cost it
+	constexpr int32 MobilityOffset[EChessPiece::Num] = { 0, 14, 7, 4, 7, 0 };
+	constexpr int32 MobilityMiddlegame[EChessPiece::Num] = { 0, 1, 5, 4, 2, 0 };
+	constexpr int32 MobilityEndgame[EChessPiece::Num] = { 0, 3, 5, 4, 4, 0 };
+
+	// Weight of each square of the enemy king zone a piece attacks
+	constexpr int32 KingAttackWeight[EChessPiece::Num] = { 0, 5, 2, 2, 3, 0 };
+	constexpr int32 MaxKingAttackScore = 500;
+	constexpr int32 PawnShieldBonus = 12;
+
+	// Indexed by rank relative to the pawn's side
+	constexpr int32 PassedPawnMiddlegame[8] = { 0, 0, 5, 10, 20, 35, 60, 0 };
+	constexpr int32 PassedPawnEndgame[8] = { 0, 5, 10, 20, 35, 60, 100, 0 };
+
+	constexpr int32 DoubledPawnMiddlegame = -10;
+	constexpr int32 DoubledPawnEndgame = -25;
+	constexpr int32 IsolatedPawnMiddlegame = -5;
+	constexpr int32 IsolatedPawnEndgame = -15;
+
+	FORCEINLINE uint64 GetAdjacentFiles(int32 File)
+	{
+		return ((File > 0) ? (ChessBitboard::FileA << (File - 1)) : 0) | ((File < 7) ? (ChessBitboard::FileA << (File + 1)) : 0);
+	}
+
+	// Ranks strictly in front of Square from Colour's point of view
+	FORCEINLINE uint64 GetForwardRanks(EChessColour::Type Colour, int32 Square)
+	{
+		const int32 Rank = ChessBitboard::GetRank(Square);
+		return (Colour == EChessColour::White) ? ((Rank < 7) ? (ChessBitboard::Full << (8 * (Rank + 1))) : 0) : ((Rank > 0) ? (ChessBitboard::Full >> (8 * (8 - Rank))) : 0);
+	}
+
+	FORCEINLINE uint64 GetPawnAttacks(EChessColour::Type Colour, uint64 Pawns)
+	{
+		const uint64 Advanced = (Colour == EChessColour::White) ? ChessBitboard::ShiftNorth(Pawns) : ChessBitboard::ShiftSouth(Pawns);
+		return ChessBitboard::ShiftEast(Advanced) | ChessBitboard::ShiftWest(Advanced);
+	}
+
+	void EvaluatePawnStructure(const FChessPosition& Position, EChessColour::Type Us, int32& Middlegame, int32& Endgame)
+	{
+		const EChessColour::Type Them = EChessColour::GetOpposite(Us);
+
+		const uint64 OurPawns = Position.GetPieces(Us, EChessPiece::Pawn);
+		const uint64 TheirPawns = Position.GetPieces(Them, EChessPiece::Pawn);
+
+		for (int32 File = 0; File < 8; File++)
+		{
+			const int32 Count = ChessBitboard::CountBits(OurPawns & (ChessBitboard::FileA << File));
+			if (Count > 1)
+			{
+				Middlegame += (Count - 1) * DoubledPawnMiddlegame;
+				Endgame += (Count - 1) * DoubledPawnEndgame;
+			}
+		}
+
+		for (uint64 Pawns = OurPawns; Pawns;)
+		{
+			const int32 Square = ChessBitboard::PopLeastSignificantSquare(Pawns);
+			const int32 File = ChessBitboard::GetFile(Square);
+			const uint64 AdjacentFiles = GetAdjacentFiles(File);
+
+			if (!(OurPawns & AdjacentFiles))
+			{
+				Middlegame += IsolatedPawnMiddlegame;
+				Endgame += IsolatedPawnEndgame;
+			}
+
+			// No enemy pawn ahead on this file or the ones next to it
+			if (!(TheirPawns & GetForwardRanks(Us, Square) & ((ChessBitboard::FileA << File) | AdjacentFiles)))
+			{
+				const int32 RelativeRank = (Us == EChessColour::White) ? ChessBitboard::GetRank(Square) : 7 - ChessBitboard::GetRank(Square);
+				Middlegame += PassedPawnMiddlegame[RelativeRank];
+				Endgame += PassedPawnEndgame[RelativeRank];
+			}
+		}
+	}
+
+	// Mobility of Us and the pressure Us puts on the enemy king, both come from the same attack sets
+	void EvaluatePieces(const FChessPosition& Position, EChessColour::Type Us, int32& Middlegame, int32& Endgame)
+	{
+		const EChessColour::Type Them = EChessColour::GetOpposite(Us);
+
+		const uint64 Occupied = Position.GetOccupied();
+
+		// Squares guarded by enemy pawns or holding our own pieces aren't worth counting
+		const uint64 MobilityArea = ~Position.GetPieces(Us) & ~GetPawnAttacks(Them, Position.GetPieces(Them, EChessPiece::Pawn));
+
+		const int32 EnemyKingSquare = Position.GetKingSquare(Them);
+		const uint64 EnemyKingZone = ChessBitboard::GetKingAttacks(EnemyKingSquare) | ChessBitboard::SquareMask(EnemyKingSquare);
+
+		int32 KingAttackers = 0;
+		int32 KingAttackUnits = 0;
+
+		for (int32 Piece = EChessPiece::Queen; Piece <= EChessPiece::Rook; Piece++)
+		{
+			for (uint64 Pieces = Position.GetPieces(Us, static_cast<EChessPiece::Type>(Piece)); Pieces;)
+			{
+				const int32 Square = ChessBitboard::PopLeastSignificantSquare(Pieces);
+
+				uint64 Attacks = 0;
+				switch (Piece)
+				{
+				case EChessPiece::Queen:	Attacks = ChessBitboard::GetQueenAttacks(Square, Occupied); break;
+				case EChessPiece::Bishop:	Attacks = ChessBitboard::GetBishopAttacks(Square, Occupied); break;
+				case EChessPiece::Knight:	Attacks = ChessBitboard::GetKnightAttacks(Square); break;
+				case EChessPiece::Rook:		Attacks = ChessBitboard::GetRookAttacks(Square, Occupied); break;
+				default:					break;
+				}
+
+				const int32 Mobility = ChessBitboard::CountBits(Attacks & MobilityArea) - MobilityOffset[Piece];
+				Middlegame += Mobility * MobilityMiddlegame[Piece];
+				Endgame += Mobility * MobilityEndgame[Piece];
+
+				if (const uint64 ZoneAttacks = Attacks & EnemyKingZone)
+				{
+					KingAttackers++;
+					KingAttackUnits += KingAttackWeight[Piece] * ChessBitboard::CountBits(ZoneAttacks);
+				}
+			}
+		}
+
+		// A lone attacker is rarely dangerous, the pressure grows quadratically once pieces coordinate
+		if (KingAttackers >= 2) Middlegame += FMath::Min(KingAttackUnits * KingAttackUnits / 4, MaxKingAttackScore);
+
+		// Pawns on the two ranks in front of our own king
+		const int32 KingSquare = Position.GetKingSquare(Us);
+		const int32 KingFile = ChessBitboard::GetFile(KingSquare);
+		const uint64 ShieldFiles = (ChessBitboard::FileA << KingFile) | GetAdjacentFiles(KingFile);
+
+		uint64 ShieldRanks = 0;
+		for (int32 Distance = 1; Distance <= 2; Distance++)
+		{
+			const int32 Rank = ChessBitboard::GetRank(KingSquare) + ((Us == EChessColour::White) ? Distance : -Distance);
+			if (Rank >= 0 && Rank < 8) ShieldRanks |= ChessBitboard::Rank1 << (8 * Rank);
+		}
+
+		Middlegame += PawnShieldBonus * ChessBitboard::CountBits(Position.GetPieces(Us, EChessPiece::Pawn) & ShieldFiles & ShieldRanks);
+	}
+}
+
+int32 FChessEvaluation::Evaluate(const FChessPosition& Position)
+{
+	// Material and piece-square terms are maintained incrementally by the position
+	int32 Middlegame = Position.GetMiddlegameScore();
+	int32 Endgame = Position.GetEndgameScore();
+
+	for (int32 Colour = 0; Colour < EChessColour::Num; Colour++)
+	{
+		int32 SideMiddlegame = 0;
+		int32 SideEndgame = 0;
+
+		EvaluatePawnStructure(Position, static_cast<EChessColour::Type>(Colour), SideMiddlegame, SideEndgame);
+		EvaluatePieces(Position, static_cast<EChessColour::Type>(Colour), SideMiddlegame, SideEndgame);
+
+		const int32 Sign = (Colour == EChessColour::White) ? 1 : -1;
+		Middlegame += Sign * SideMiddlegame;
+		Endgame += Sign * SideEndgame;
+	}
+
+	// Blend towards the endgame score as pieces come off
+	const int32 Phase = FMath::Min(Position.GetPhase(), ChessPieceSquare::MaxPhase);
+	const int32 Score = (Middlegame * Phase + Endgame * (ChessPieceSquare::MaxPhase - Phase)) / ChessPieceSquare::MaxPhase;
+
+	return (Position.GetSideToMove() == EChessColour::White) ? Score : -Score;
+}
+
+int32 FChessEvaluation::StaticExchange(const FChessPosition& Position, FChessMove Move)
+{
+	if (Move.IsCastle()) return 0;
+
+	const int32 From = Move.GetFrom();
+	const int32 To = Move.GetTo();
+
+	// Least valuable first, the king last since it can only take when nothing defends
+	static constexpr EChessPiece::Type AttackerOrder[EChessPiece::Num] = { EChessPiece::Pawn, EChessPiece::Knight, EChessPiece::Bishop, EChessPiece::Rook, EChessPiece::Queen, EChessPiece::King };
+
+	const EChessPiece::Type MovingPiece = Position.GetPieceTypeOnSquare(From);
+	const EChessPiece::Type CapturedPiece = Move.IsEnPassant() ? EChessPiece::Pawn : Position.GetPieceTypeOnSquare(To);
+
+	uint64 Occupied = Position.GetOccupied() ^ ChessBitboard::SquareMask(From);
+	if (Move.IsEnPassant()) Occupied ^= ChessBitboard::SquareMask(To + (Position.GetSideToMove() == EChessColour::White ? -8 : 8));
+
+	// Gain[i] is what the side making capture i is up if the sequence stops right after it
+	constexpr int32 MaxExchanges = 32;
+	int32 Gain[MaxExchanges];
+	int32 Depth = 0;
+
+	Gain[0] = (CapturedPiece != EChessPiece::None) ? PieceValues[CapturedPiece] : 0;
+
+	// Value of the piece now standing on the target square, the next one to be taken
+	int32 Victim = PieceValues[MovingPiece];
+
+	if (Move.IsPromotion())
+	{
+		Gain[0] += PieceValues[Move.GetPromotionPiece()] - PieceValues[EChessPiece::Pawn];
+		Victim = PieceValues[Move.GetPromotionPiece()];
+	}
+
+	const uint64 DiagonalSliders = Position.GetPieces(EChessPiece::Bishop) | Position.GetPieces(EChessPiece::Queen);
+	const uint64 StraightSliders = Position.GetPieces(EChessPiece::Rook) | Position.GetPieces(EChessPiece::Queen);
+
+	uint64 Attackers = Position.GetAttackersTo(To, Occupied) & Occupied;
+	EChessColour::Type Side = EChessColour::GetOpposite(Position.GetSideToMove());
+
+	while (Depth < MaxExchanges - 1)
+	{
+		const uint64 SideAttackers = Attackers & Position.GetPieces(Side);
+		if (!SideAttackers) break;
+
+		EChessPiece::Type Piece = EChessPiece::None;
+		uint64 PieceAttackers = 0;
+
+		for (EChessPiece::Type Candidate : AttackerOrder)
+		{
+			PieceAttackers = SideAttackers & Position.GetPieces(Side, Candidate);
+			if (PieceAttackers)
+			{
+				Piece = Candidate;
+				break;
+			}
+		}
+
+		// The king can't take into a defended square
+		if (Piece == EChessPiece::King && (Attackers & Position.GetPieces(EChessColour::GetOpposite(Side)))) break;
+
+		Depth++;
+		Gain[Depth] = Victim - Gain[Depth - 1];
+
+		Occupied ^= PieceAttackers & (~PieceAttackers + 1);
+
+		// Sliders lined up behind the piece that just moved join in
+		if (Piece == EChessPiece::Pawn || Piece == EChessPiece::Bishop || Piece == EChessPiece::Queen) Attackers |= ChessBitboard::GetBishopAttacks(To, Occupied) & DiagonalSliders;
+		if (Piece == EChessPiece::Rook || Piece == EChessPiece::Queen) Attackers |= ChessBitboard::GetRookAttacks(To, Occupied) & StraightSliders;
+		Attackers &= Occupied;
+
+		Victim = PieceValues[Piece];
+		Side = EChessColour::GetOpposite(Side);
+	}
+
+	// Unwind : at every step the side to capture picks the better of stopping or carrying on
+	for (; Depth > 0; Depth--)
+		Gain[Depth - 1] = -FMath::Max(-Gain[Depth - 1], Gain[Depth]);
+
+	return Gain[0];
+}
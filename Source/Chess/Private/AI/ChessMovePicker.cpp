@@ -0,0 +1,128 @@
+// Copyright Kunal Patil (kroxyserver). All Rights Reserved.
+
+#include "AI/ChessMovePicker.h"
+
+#include "AI/ChessEvaluation.h"
+#include "Board/ChessMoveGenerator.h"
+#include "Board/ChessPosition.h"
+
+int32 ChessMoveOrdering::GetCaptureScore(const FChessPosition& Position, FChessMove Move)
+{
+	const EChessPiece::Type Victim = Move.IsEnPassant() ? EChessPiece::Pawn : Position.GetPieceTypeOnSquare(Move.GetTo());
+	const EChessPiece::Type Promotion = Move.GetPromotionPiece();
+
+	const int32 Gain = ((Victim != EChessPiece::None) ? FChessEvaluation::PieceValues[Victim] : 0) + ((Promotion != EChessPiece::None) ? FChessEvaluation::PieceValues[Promotion] : 0);
+
+	return Gain * 16 - FChessEvaluation::PieceValues[Position.GetPieceTypeOnSquare(Move.GetFrom())] / 10;
+}
+
+FChessMovePicker::FChessMovePicker(FChessPosition& InPosition, FChessMove InHashMove, const FChessMove* InKillers, FChessMove InCounterMove, const FChessHistory& InHistory) :
+	Position(InPosition),
+	History(InHistory),
+	HashMove(InHashMove),
+	CounterMove(InCounterMove)
+{
+	Killers[0] = InKillers ? InKillers[0] : FChessMove();
+	Killers[1] = InKillers ? InKillers[1] : FChessMove();
+}
+
+FChessMove FChessMovePicker::Next()
+{
+	switch (Stage)
+	{
+	case EChessMovePickerStage::HashMove:
+		Stage = EChessMovePickerStage::GenerateCaptures;
+		if (IsUsable(HashMove)) return HashMove;
+		HashMove = FChessMove();
+		[[fallthrough]];
+
+	case EChessMovePickerStage::GenerateCaptures:
+		FChessMoveGenerator::GenerateLegalCaptures(Position, Moves);
+		for (int32 i = 0; i < Moves.Num; i++) Scores[i] = ChessMoveOrdering::GetCaptureScore(Position, Moves[i]);
+		Current = 0;
+		Stage = EChessMovePickerStage::GoodCaptures;
+		[[fallthrough]];
+
+	case EChessMovePickerStage::GoodCaptures:
+		while (Current < Moves.Num)
+		{
+			const FChessMove Move = PickBest();
+			if (Move == HashMove) continue;
+
+			// Underpromotions are kept for last along with the captures that lose material
+			if (FChessEvaluation::StaticExchange(Position, Move) < 0 || (Move.IsPromotion() && Move.GetPromotionPiece() != EChessPiece::Queen))
+			{
+				BadCaptures.Add(Move);
+				continue;
+			}
+
+			return Move;
+		}
+		Stage = EChessMovePickerStage::FirstKiller;
+		[[fallthrough]];
+
+	case EChessMovePickerStage::FirstKiller:
+		Stage = EChessMovePickerStage::SecondKiller;
+		if (Killers[0] != HashMove && Killers[0].IsQuiet() && IsUsable(Killers[0])) return Killers[0];
+		Killers[0] = FChessMove();
+		[[fallthrough]];
+
+	case EChessMovePickerStage::SecondKiller:
+		Stage = EChessMovePickerStage::CounterMove;
+		if (Killers[1] != HashMove && Killers[1] != Killers[0] && Killers[1].IsQuiet() && IsUsable(Killers[1])) return Killers[1];
+		Killers[1] = FChessMove();
+		[[fallthrough]];
+
+	case EChessMovePickerStage::CounterMove:
+		Stage = EChessMovePickerStage::GenerateQuiets;
+		if (CounterMove != HashMove && CounterMove != Killers[0] && CounterMove != Killers[1] && CounterMove.IsQuiet() && IsUsable(CounterMove)) return CounterMove;
+		CounterMove = FChessMove();
+		[[fallthrough]];
+
+	case EChessMovePickerStage::GenerateQuiets:
+		FChessMoveGenerator::GenerateLegalQuiets(Position, Moves);
+		for (int32 i = 0; i < Moves.Num; i++) Scores[i] = History.Get(Position.GetSideToMove(), Moves[i]);
+		Current = 0;
+		Stage = EChessMovePickerStage::Quiets;
+		[[fallthrough]];
+
+	case EChessMovePickerStage::Quiets:
+		while (Current < Moves.Num)
+		{
+			const FChessMove Move = PickBest();
+			if (!IsSpecialMove(Move)) return Move;
+		}
+		Stage = EChessMovePickerStage::BadCaptures;
+		[[fallthrough]];
+
+	case EChessMovePickerStage::BadCaptures:
+		if (CurrentBadCapture < BadCaptures.Num) return BadCaptures[CurrentBadCapture++];
+		Stage = EChessMovePickerStage::Done;
+		[[fallthrough]];
+
+	default:
+		return FChessMove();
+	}
+}
+
+FChessMove FChessMovePicker::PickBest()
+{
+	int32 BestIndex = Current;
+	for (int32 i = Current + 1; i < Moves.Num; i++)
+		if (Scores[i] > Scores[BestIndex]) BestIndex = i;
+
+	Swap(Moves[Current], Moves[BestIndex]);
+	Swap(Scores[Current], Scores[BestIndex]);
+
+	return Moves[Current++];
+}
+
+bool FChessMovePicker::IsUsable(FChessMove Move) const
+{
+	return FChessMoveGenerator::IsPseudoLegal(Position, Move) && FChessMoveGenerator::IsLegal(Position, Move);
+}
+
+bool FChessMovePicker::IsSpecialMove(FChessMove Move) const
+{
+	return Move == HashMove || Move == Killers[0] || Move == Killers[1] || Move == CounterMove;
+}
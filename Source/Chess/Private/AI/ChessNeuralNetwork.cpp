@@ -0,0 +1,353 @@
+// Copyright Kunal Patil (kroxyserver). All Rights Reserved.
+
+#include "AI/ChessNeuralNetwork.h"
+
+#include "Chess/Chess.h"
+
+#include "Board/ChessPosition.h"
+
+#include "Misc/FileHelper.h"
+
+// 0 scalar, 1 SSE2, 2 AVX2, 3 NEON, picked from what the compiler targets unless the build forces one
+#ifndef CHESS_NNUE_SIMD
+	#if PLATFORM_CPU_X86_FAMILY && defined(__AVX2__)
+		#define CHESS_NNUE_SIMD 2
+	#elif PLATFORM_CPU_X86_FAMILY && (defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64))
+		#define CHESS_NNUE_SIMD 1
+	#elif PLATFORM_CPU_ARM_FAMILY && (defined(__ARM_NEON) || defined(_M_ARM64))
+		#define CHESS_NNUE_SIMD 3
+	#else
+		#define CHESS_NNUE_SIMD 0
+	#endif
+#endif
+
+#if CHESS_NNUE_SIMD == 1 || CHESS_NNUE_SIMD == 2
+	#include <immintrin.h>
+#elif CHESS_NNUE_SIMD == 3
+	#include <arm_neon.h>
+#endif
+
+using namespace ChessNeuralNetwork;
+
+namespace
+{
+	// Thin wrappers so the accumulator and output loops are written once for every instruction set
+#if CHESS_NNUE_SIMD == 2
+	using FVector16 = __m256i;
+	using FVector32 = __m256i;
+	constexpr int32 Lanes = 16;
+
+	FORCEINLINE FVector16 Load(const int16* Source) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Source)); }
+	FORCEINLINE void Store(int16* Destination, FVector16 Value) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(Destination), Value); }
+	FORCEINLINE FVector16 Add(FVector16 A, FVector16 B) { return _mm256_add_epi16(A, B); }
+	FORCEINLINE FVector16 Subtract(FVector16 A, FVector16 B) { return _mm256_sub_epi16(A, B); }
+	FORCEINLINE FVector16 Clamp(FVector16 Value, FVector16 Min, FVector16 Max) { return _mm256_min_epi16(_mm256_max_epi16(Value, Min), Max); }
+	FORCEINLINE FVector16 Multiply(FVector16 A, FVector16 B) { return _mm256_mullo_epi16(A, B); }
+	FORCEINLINE FVector16 Splat(int16 Value) { return _mm256_set1_epi16(Value); }
+	FORCEINLINE FVector32 Zero32() { return _mm256_setzero_si256(); }
+	FORCEINLINE FVector32 MultiplyAdd(FVector32 Sum, FVector16 A, FVector16 B) { return _mm256_add_epi32(Sum, _mm256_madd_epi16(A, B)); }
+
+	FORCEINLINE int32 ReduceAdd(FVector32 Sum)
+	{
+		__m128i Half = _mm_add_epi32(_mm256_castsi256_si128(Sum), _mm256_extracti128_si256(Sum, 1));
+		Half = _mm_add_epi32(Half, _mm_shuffle_epi32(Half, _MM_SHUFFLE(1, 0, 3, 2)));
+		Half = _mm_add_epi32(Half, _mm_shuffle_epi32(Half, _MM_SHUFFLE(2, 3, 0, 1)));
+		return _mm_cvtsi128_si32(Half);
+	}
+#elif CHESS_NNUE_SIMD == 1
+	using FVector16 = __m128i;
+	using FVector32 = __m128i;
+	constexpr int32 Lanes = 8;
+
+	FORCEINLINE FVector16 Load(const int16* Source) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(Source)); }
+	FORCEINLINE void Store(int16* Destination, FVector16 Value) { _mm_storeu_si128(reinterpret_cast<__m128i*>(Destination), Value); }
+	FORCEINLINE FVector16 Add(FVector16 A, FVector16 B) { return _mm_add_epi16(A, B); }
+	FORCEINLINE FVector16 Subtract(FVector16 A, FVector16 B) { return _mm_sub_epi16(A, B); }
+	FORCEINLINE FVector16 Clamp(FVector16 Value, FVector16 Min, FVector16 Max) { return _mm_min_epi16(_mm_max_epi16(Value, Min), Max); }
+	FORCEINLINE FVector16 Multiply(FVector16 A, FVector16 B) { return _mm_mullo_epi16(A, B); }
+	FORCEINLINE FVector16 Splat(int16 Value) { return _mm_set1_epi16(Value); }
+	FORCEINLINE FVector32 Zero32() { return _mm_setzero_si128(); }
+	FORCEINLINE FVector32 MultiplyAdd(FVector32 Sum, FVector16 A, FVector16 B) { return _mm_add_epi32(Sum, _mm_madd_epi16(A, B)); }
+
+	FORCEINLINE int32 ReduceAdd(FVector32 Sum)
+	{
+		Sum = _mm_add_epi32(Sum, _mm_shuffle_epi32(Sum, _MM_SHUFFLE(1, 0, 3, 2)));
+		Sum = _mm_add_epi32(Sum, _mm_shuffle_epi32(Sum, _MM_SHUFFLE(2, 3, 0, 1)));
+		return _mm_cvtsi128_si32(Sum);
+	}
+#elif CHESS_NNUE_SIMD == 3
+	using FVector16 = int16x8_t;
+	using FVector32 = int32x4_t;
+	constexpr int32 Lanes = 8;
+
+	FORCEINLINE FVector16 Load(const int16* Source) { return vld1q_s16(Source); }
+	FORCEINLINE void Store(int16* Destination, FVector16 Value) { vst1q_s16(Destination, Value); }
+	FORCEINLINE FVector16 Add(FVector16 A, FVector16 B) { return vaddq_s16(A, B); }
+	FORCEINLINE FVector16 Subtract(FVector16 A, FVector16 B) { return vsubq_s16(A, B); }
+	FORCEINLINE FVector16 Clamp(FVector16 Value, FVector16 Min, FVector16 Max) { return vminq_s16(vmaxq_s16(Value, Min), Max); }
+	FORCEINLINE FVector16 Multiply(FVector16 A, FVector16 B) { return vmulq_s16(A, B); }
+	FORCEINLINE FVector16 Splat(int16 Value) { return vdupq_n_s16(Value); }
+	FORCEINLINE FVector32 Zero32() { return vdupq_n_s32(0); }
+	FORCEINLINE FVector32 MultiplyAdd(FVector32 Sum, FVector16 A, FVector16 B)
+	{
+		Sum = vmlal_s16(Sum, vget_low_s16(A), vget_low_s16(B));
+		return vmlal_s16(Sum, vget_high_s16(A), vget_high_s16(B));
+	}
+	FORCEINLINE int32 ReduceAdd(FVector32 Sum) { return vaddvq_s32(Sum); }
+#endif
+
+#if CHESS_NNUE_SIMD
+	static_assert(HiddenSize % Lanes == 0, "HiddenSize must be a multiple of the vector width");
+#endif
+
+	// Trainer order is pawn, knight, bishop, rook, queen, king, indexed here by EChessPiece::Type
+	constexpr int32 TrainerPieceIndex[EChessPiece::Num] = { 5, 4, 2, 1, 3, 0 };
+
+	FORCEINLINE int32 GetFeatureIndex(EChessColour::Type Perspective, EChessColour::Type Colour, EChessPiece::Type Piece, int32 Square)
+	{
+		const int32 OrientedSquare = (Perspective == EChessColour::White) ? Square : (Square ^ 56);
+		return (((Colour != Perspective) ? 6 : 0) + TrainerPieceIndex[Piece]) * 64 + OrientedSquare;
+	}
+
+	struct FFeatureChange
+	{
+		EChessColour::Type Colour;
+		EChessPiece::Type Piece;
+		int32 Square;
+	};
+
+	constexpr int64 NumFeatureWeights = static_cast<int64>(NumFeatures) * HiddenSize;
+
+	// Weights plus the single output bias, padded to 64 bytes by the trainer
+	constexpr int64 NetworkSizeInBytes = (NumFeatureWeights + HiddenSize + 2 * HiddenSize + 1) * sizeof(int16);
+}
+
+FChessNeuralNetwork::FChessNeuralNetwork() :
+	OutputBias(0),
+	bIsLoaded(false)
+{
+}
+
+bool FChessNeuralNetwork::LoadFromFile(const FString& FilePath)
+{
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *FilePath))
+	{
+		UE_LOG(LogChess, Error, TEXT("Couldn't read neural network file %s"), *FilePath);
+		return false;
+	}
+
+	return LoadFromMemory(Bytes.GetData(), Bytes.Num());
+}
+
+bool FChessNeuralNetwork::LoadFromMemory(const uint8* Data, int64 Size)
+{
+	bIsLoaded = false;
+
+	if (!Data || Size < NetworkSizeInBytes)
+	{
+		UE_LOG(LogChess, Error, TEXT("Neural network is %lld bytes, expected at least %lld for a %d x %d network"), Size, NetworkSizeInBytes, NumFeatures, HiddenSize);
+		return false;
+	}
+
+	FeatureWeights.SetNumUninitialized(NumFeatureWeights);
+	FeatureBiases.SetNumUninitialized(HiddenSize);
+	OutputWeights.SetNumUninitialized(2 * HiddenSize);
+
+	const int16* Source = reinterpret_cast<const int16*>(Data);
+
+	FMemory::Memcpy(FeatureWeights.GetData(), Source, NumFeatureWeights * sizeof(int16));
+	Source += NumFeatureWeights;
+
+	FMemory::Memcpy(FeatureBiases.GetData(), Source, HiddenSize * sizeof(int16));
+	Source += HiddenSize;
+
+	FMemory::Memcpy(OutputWeights.GetData(), Source, 2 * HiddenSize * sizeof(int16));
+	Source += 2 * HiddenSize;
+
+	FMemory::Memcpy(&OutputBias, Source, sizeof(int16));
+
+	// The vector path multiplies activation by weight in 16 bits before widening, which only fits while |weight| < 128
+	for (const int16 Weight : OutputWeights)
+	{
+		if (Weight < -127 || Weight > 127)
+		{
+			UE_LOG(LogChess, Error, TEXT("Neural network output weight %d is out of range, the trainer should clip them to +-1.98"), Weight);
+			return false;
+		}
+	}
+
+	bIsLoaded = true;
+	return true;
+}
+
+void FChessNeuralNetwork::InitializeRandom(uint32 Seed)
+{
+	FRandomStream Random(Seed);
+
+	FeatureWeights.SetNumUninitialized(NumFeatureWeights);
+	FeatureBiases.SetNumUninitialized(HiddenSize);
+	OutputWeights.SetNumUninitialized(2 * HiddenSize);
+
+	for (int16& Weight : FeatureWeights) Weight = static_cast<int16>(Random.RandRange(-32, 32));
+	for (int16& Bias : FeatureBiases) Bias = static_cast<int16>(Random.RandRange(0, 64));
+	for (int16& Weight : OutputWeights) Weight = static_cast<int16>(Random.RandRange(-64, 64));
+
+	OutputBias = 0;
+	bIsLoaded = true;
+}
+
+void FChessNeuralNetwork::RefreshAccumulator(const FChessPosition& Position, FChessAccumulator& OutAccumulator) const
+{
+	for (int32 Perspective = 0; Perspective < EChessColour::Num; Perspective++)
+	{
+		int16* Values = OutAccumulator.Values[Perspective];
+		FMemory::Memcpy(Values, FeatureBiases.GetData(), HiddenSize * sizeof(int16));
+
+		for (uint64 Pieces = Position.GetOccupied(); Pieces;)
+		{
+			const int32 Square = ChessBitboard::PopLeastSignificantSquare(Pieces);
+
+			EChessColour::Type Colour;
+			EChessPiece::Type Piece;
+			Position.GetPieceOnSquare(Square, Colour, Piece);
+
+			const int16* Weights = &FeatureWeights[GetFeatureIndex(static_cast<EChessColour::Type>(Perspective), Colour, Piece, Square) * HiddenSize];
+
+			for (int32 i = 0; i < HiddenSize; i++) Values[i] += Weights[i];
+		}
+	}
+}
+
+void FChessNeuralNetwork::UpdateAccumulator(const FChessAccumulator& Parent, FChessAccumulator& OutChild, const FChessPosition& Position, FChessMove Move) const
+{
+	const EChessColour::Type Us = Position.GetSideToMove();
+	const EChessColour::Type Them = EChessColour::GetOpposite(Us);
+
+	const int32 From = Move.GetFrom();
+	const int32 To = Move.GetTo();
+	const EChessPiece::Type MovingPiece = Position.GetPieceTypeOnSquare(From);
+
+	// At most two features come and go, castling moves two pieces and a capture removes two
+	FFeatureChange Added[2];
+	FFeatureChange Removed[2];
+	int32 NumAdded = 0;
+	int32 NumRemoved = 0;
+
+	Removed[NumRemoved++] = { Us, MovingPiece, From };
+	Added[NumAdded++] = { Us, Move.IsPromotion() ? Move.GetPromotionPiece() : MovingPiece, To };
+
+	if (Move.IsEnPassant())
+	{
+		Removed[NumRemoved++] = { Them, EChessPiece::Pawn, (Us == EChessColour::White) ? To - 8 : To + 8 };
+	}
+	else if (Move.IsCapture())
+	{
+		Removed[NumRemoved++] = { Them, Position.GetPieceTypeOnSquare(To), To };
+	}
+	else if (Move.GetFlag() == EChessMoveFlag::KingCastle)
+	{
+		Removed[NumRemoved++] = { Us, EChessPiece::Rook, To + 1 };
+		Added[NumAdded++] = { Us, EChessPiece::Rook, To - 1 };
+	}
+	else if (Move.GetFlag() == EChessMoveFlag::QueenCastle)
+	{
+		Removed[NumRemoved++] = { Us, EChessPiece::Rook, To - 2 };
+		Added[NumAdded++] = { Us, EChessPiece::Rook, To + 1 };
+	}
+
+	for (int32 Perspective = 0; Perspective < EChessColour::Num; Perspective++)
+	{
+		const EChessColour::Type PerspectiveColour = static_cast<EChessColour::Type>(Perspective);
+
+		const int16* AddedWeights[2] = {};
+		const int16* RemovedWeights[2] = {};
+
+		for (int32 i = 0; i < NumAdded; i++)
+			AddedWeights[i] = &FeatureWeights[GetFeatureIndex(PerspectiveColour, Added[i].Colour, Added[i].Piece, Added[i].Square) * HiddenSize];
+
+		for (int32 i = 0; i < NumRemoved; i++)
+			RemovedWeights[i] = &FeatureWeights[GetFeatureIndex(PerspectiveColour, Removed[i].Colour, Removed[i].Piece, Removed[i].Square) * HiddenSize];
+
+		const int16* Source = Parent.Values[Perspective];
+		int16* Destination = OutChild.Values[Perspective];
+
+		// One pass over the accumulator whatever the move, reading the parent and writing the child
+#if CHESS_NNUE_SIMD
+		for (int32 i = 0; i < HiddenSize; i += Lanes)
+		{
+			FVector16 Value = Subtract(Add(Load(Source + i), Load(AddedWeights[0] + i)), Load(RemovedWeights[0] + i));
+
+			if (NumAdded > 1) Value = Add(Value, Load(AddedWeights[1] + i));
+			if (NumRemoved > 1) Value = Subtract(Value, Load(RemovedWeights[1] + i));
+
+			Store(Destination + i, Value);
+		}
+#else
+		for (int32 i = 0; i < HiddenSize; i++)
+		{
+			int16 Value = Source[i] + AddedWeights[0][i] - RemovedWeights[0][i];
+
+			if (NumAdded > 1) Value += AddedWeights[1][i];
+			if (NumRemoved > 1) Value -= RemovedWeights[1][i];
+
+			Destination[i] = Value;
+		}
+#endif
+	}
+}
+
+int32 FChessNeuralNetwork::Evaluate(const FChessAccumulator& Accumulator, EChessColour::Type SideToMove) const
+{
+	const int16* Perspectives[2] = { Accumulator.Values[SideToMove], Accumulator.Values[EChessColour::GetOpposite(SideToMove)] };
+
+	int32 Sum = 0;
+
+#if CHESS_NNUE_SIMD
+	// clamp(x)^2 * w computed as clamp(x) * (clamp(x) * w), the inner product stays in 16 bits and madd widens the outer one
+	const FVector16 Zero = Splat(0);
+	const FVector16 Max = Splat(QA);
+
+	FVector32 VectorSum = Zero32();
+
+	for (int32 Half = 0; Half < 2; Half++)
+	{
+		const int16* Weights = &OutputWeights[Half * HiddenSize];
+
+		for (int32 i = 0; i < HiddenSize; i += Lanes)
+		{
+			const FVector16 Activation = Clamp(Load(Perspectives[Half] + i), Zero, Max);
+			VectorSum = MultiplyAdd(VectorSum, Activation, Multiply(Activation, Load(Weights + i)));
+		}
+	}
+
+	Sum = ReduceAdd(VectorSum);
+#else
+	for (int32 Half = 0; Half < 2; Half++)
+	{
+		const int16* Weights = &OutputWeights[Half * HiddenSize];
+
+		for (int32 i = 0; i < HiddenSize; i++)
+		{
+			const int32 Activation = FMath::Clamp<int32>(Perspectives[Half][i], 0, QA);
+			Sum += Activation * Activation * Weights[i];
+		}
+	}
+#endif
+
+	// Squaring left an extra factor of QA in the sum
+	return (Sum / QA + OutputBias) * OutputScale / (QA * QB);
+}
+
+const TCHAR* FChessNeuralNetwork::GetSimdName()
+{
+#if CHESS_NNUE_SIMD == 2
+	return TEXT("AVX2");
+#elif CHESS_NNUE_SIMD == 1
+	return TEXT("SSE2");
+#elif CHESS_NNUE_SIMD == 3
+	return TEXT("NEON");
+#else
+	return TEXT("Scalar");
+#endif
+}
@@ -0,0 +1,249 @@
+// Copyright Kunal Patil (kroxyserver). All Rights Reserved.
+
+#include "AI/ChessOpeningBook.h"
+
+#include "Chess/Chess.h"
+
+#include "Board/ChessMoveGenerator.h"
+#include "Board/ChessPosition.h"
+
+#include "Async/MappedFileHandle.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+
+namespace
+{
+	// Polyglot orders pieces pawn, knight, bishop, rook, queen, king, indexed here by EChessPiece::Type
+	constexpr int32 PolyglotPieceType[EChessPiece::Num] = { 5, 4, 2, 1, 3, 0 };
+
+	// Indexed by the 3 bit promotion field of a book move, 0 is no promotion
+	constexpr EChessPiece::Type PolyglotPromotionPiece[5] = { EChessPiece::None, EChessPiece::Knight, EChessPiece::Bishop, EChessPiece::Rook, EChessPiece::Queen };
+
+	const FChessPolyglotTestKey PolyglotTestKeys[] =
+	{
+		{ TEXT("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"), ChessPolyglot::StartingPositionKey },
+		{ TEXT("rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq e3 0 1"), 0x823C9B50FD114196ULL },
+		{ TEXT("rnbqkbnr/ppp1pppp/8/3p4/4P3/8/PPPP1PPP/RNBQKBNR w KQkq d6 0 2"), 0x0756B94461C50FB0ULL },
+		{ TEXT("rnbqkbnr/ppp1pppp/8/3pP3/8/8/PPPP1PPP/RNBQKBNR b KQkq - 0 2"), 0x662FAFB965DB29D4ULL },
+		{ TEXT("rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq f6 0 3"), 0x22A48B5A8E47FF78ULL },
+		{ TEXT("rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPPKPPP/RNBQ1BNR b kq - 0 3"), 0x652A607CA3F242C1ULL },
+		{ TEXT("rnbq1bnr/ppp1pkpp/8/3pPp2/8/8/PPPPKPPP/RNBQ1BNR w - - 0 4"), 0x00FDD303C946BDD9ULL },
+		{ TEXT("rnbqkbnr/p1pppppp/8/8/PpP4P/8/1P1PPPP1/RNBQKBNR b KQkq c3 0 3"), 0x3C8123EA7B067637ULL },
+		{ TEXT("rnbqkbnr/p1pppppp/8/8/P6P/R1p5/1P1PPPP1/1NBQKBNR b Kkq - 0 4"), 0x5C3F9B829B279560ULL },
+	};
+}
+
+FChessOpeningBook::FChessOpeningBook() = default;
+
+FChessOpeningBook::~FChessOpeningBook()
+{
+	Close();
+}
+
+bool FChessOpeningBook::Open(const FString& BookFile, const FString& KeysFile)
+{
+	Close();
+
+	if (!LoadRandomKeys(KeysFile)) return false;
+
+	MappedFile.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*BookFile));
+	if (!MappedFile.IsValid())
+	{
+		UE_LOG(LogChess, Error, TEXT("Couldn't map opening book %s"), *BookFile);
+		Close();
+		return false;
+	}
+
+	const int64 FileSize = MappedFile->GetFileSize();
+	if (FileSize <= 0 || FileSize % ChessPolyglot::EntrySize != 0)
+	{
+		UE_LOG(LogChess, Error, TEXT("Opening book %s is %lld bytes, not a whole number of %d byte entries"), *BookFile, FileSize, ChessPolyglot::EntrySize);
+		Close();
+		return false;
+	}
+
+	MappedRegion.Reset(MappedFile->MapRegion(0, FileSize));
+	if (!MappedRegion.IsValid())
+	{
+		UE_LOG(LogChess, Error, TEXT("Couldn't map opening book %s"), *BookFile);
+		Close();
+		return false;
+	}
+
+	Entries = MappedRegion->GetMappedPtr();
+	NumEntries = FileSize / ChessPolyglot::EntrySize;
+
+	return true;
+}
+
+void FChessOpeningBook::Close()
+{
+	// The region has to go before the file it maps
+	Entries = nullptr;
+	NumEntries = 0;
+	MappedRegion.Reset();
+	MappedFile.Reset();
+	RandomKeys.Reset();
+}
+
+bool FChessOpeningBook::LoadRandomKeys(const FString& KeysFile)
+{
+	RandomKeys.Reset();
+
+	TArray<uint8> KeyBytes;
+	if (!FFileHelper::LoadFileToArray(KeyBytes, *KeysFile) || KeyBytes.Num() != ChessPolyglot::NumRandomKeys * 8)
+	{
+		UE_LOG(LogChess, Error, TEXT("Polyglot key file %s should hold exactly %d keys"), *KeysFile, ChessPolyglot::NumRandomKeys);
+		return false;
+	}
+
+	RandomKeys.SetNumUninitialized(ChessPolyglot::NumRandomKeys);
+	for (int32 i = 0; i < ChessPolyglot::NumRandomKeys; i++)
+		RandomKeys[i] = ReadBigEndian(KeyBytes.GetData() + i * 8, 8);
+
+	// A table from another program, read in the wrong order or byte order, or with a single bad key would quietly miss book positions
+	for (const FChessPolyglotTestKey& TestKey : PolyglotTestKeys)
+	{
+		FChessPosition Position;
+		Position.SetFromFen(TestKey.Fen);
+
+		if (ComputeKey(Position) != TestKey.Key)
+		{
+			UE_LOG(LogChess, Error, TEXT("Polyglot key file %s doesn't reproduce the specification's key for %s"), *KeysFile, TestKey.Fen);
+			RandomKeys.Reset();
+			return false;
+		}
+	}
+
+	return true;
+}
+
+uint64 FChessOpeningBook::ComputeKey(const FChessPosition& Position) const
+{
+	if (RandomKeys.Num() != ChessPolyglot::NumRandomKeys) return 0;
+
+	uint64 Key = 0;
+
+	for (int32 Colour = 0; Colour < EChessColour::Num; Colour++)
+	{
+		for (int32 Piece = 0; Piece < EChessPiece::Num; Piece++)
+		{
+			const int32 Kind = PolyglotPieceType[Piece] * 2 + (Colour == EChessColour::White ? 1 : 0);
+
+			for (uint64 Pieces = Position.GetPieces(static_cast<EChessColour::Type>(Colour), static_cast<EChessPiece::Type>(Piece)); Pieces;)
+				Key ^= RandomKeys[64 * Kind + ChessBitboard::PopLeastSignificantSquare(Pieces)];
+		}
+	}
+
+	// Same bit order as EChessCastlingRights
+	for (int32 i = 0; i < 4; i++)
+		if (Position.GetCastlingRights() & (1 << i)) Key ^= RandomKeys[ChessPolyglot::CastlingKeyOffset + i];
+
+	// Like FChessPosition's own key, en passant only counts when a pawn of the side to move can actually take
+	const int32 EnPassantSquare = Position.GetEnPassantSquare();
+	if (EnPassantSquare >= 0)
+	{
+		const EChessColour::Type Us = Position.GetSideToMove();
+		if (ChessBitboard::GetPawnAttacks(Us != EChessColour::White, EnPassantSquare) & Position.GetPieces(Us, EChessPiece::Pawn))
+			Key ^= RandomKeys[ChessPolyglot::EnPassantKeyOffset + ChessBitboard::GetFile(EnPassantSquare)];
+	}
+
+	if (Position.GetSideToMove() == EChessColour::White) Key ^= RandomKeys[ChessPolyglot::TurnKeyOffset];
+
+	return Key;
+}
+
+void FChessOpeningBook::GetMoves(const FChessPosition& Position, TArray<FChessBookMove>& OutMoves) const
+{
+	OutMoves.Reset();
+
+	if (!IsOpen()) return;
+
+	const uint64 Key = ComputeKey(Position);
+
+	for (int64 Index = FindFirstEntry(Key); Index < NumEntries && GetEntryKey(Index) == Key; Index++)
+	{
+		const uint8* Entry = Entries + Index * ChessPolyglot::EntrySize;
+
+		FChessBookMove BookMove;
+		BookMove.Move = DecodeMove(static_cast<uint16>(ReadBigEndian(Entry + 8, 2)), Position);
+		BookMove.Weight = static_cast<uint16>(ReadBigEndian(Entry + 10, 2));
+
+		// A key collision or a broken book can name a move that isn't legal here
+		if (BookMove.Move.IsValid()) OutMoves.Add(BookMove);
+	}
+}
+
+FChessMove FChessOpeningBook::PickMove(const FChessPosition& Position, FRandomStream& Random) const
+{
+	TArray<FChessBookMove> BookMoves;
+	GetMoves(Position, BookMoves);
+
+	int32 TotalWeight = 0;
+	for (const FChessBookMove& BookMove : BookMoves) TotalWeight += BookMove.Weight;
+
+	// Weight 0 means the book author doesn't want the move played
+	if (TotalWeight == 0) return FChessMove();
+
+	int32 Roll = Random.RandRange(0, TotalWeight - 1);
+
+	for (const FChessBookMove& BookMove : BookMoves)
+	{
+		if (Roll < BookMove.Weight) return BookMove.Move;
+		Roll -= BookMove.Weight;
+	}
+
+	return FChessMove();
+}
+
+TConstArrayView<FChessPolyglotTestKey> FChessOpeningBook::GetTestKeys()
+{
+	return PolyglotTestKeys;
+}
+
+int64 FChessOpeningBook::FindFirstEntry(uint64 Key) const
+{
+	// Lower bound, entries are sorted by key and a position may have several
+	int64 Low = 0;
+	int64 High = NumEntries;
+
+	while (Low < High)
+	{
+		const int64 Middle = Low + (High - Low) / 2;
+
+		if (GetEntryKey(Middle) < Key) Low = Middle + 1;
+		else High = Middle;
+	}
+
+	return Low;
+}
+
+FChessMove FChessOpeningBook::DecodeMove(uint16 BookMove, const FChessPosition& Position)
+{
+	// Bits 0-5 To, 6-11 From, both rank * 8 + file like ours, 12-14 promotion piece
+	const int32 From = (BookMove >> 6) & 0x3F;
+	int32 To = BookMove & 0x3F;
+	const int32 Promotion = (BookMove >> 12) & 0x7;
+
+	if (Promotion > 4) return FChessMove();
+
+	// Castling is written as the king taking its own rook
+	const EChessColour::Type Us = Position.GetSideToMove();
+	if (From == Position.GetKingSquare(Us) && (Position.GetPieces(Us, EChessPiece::Rook) & ChessBitboard::SquareMask(To)))
+		To = (To > From) ? From + 2 : From - 2;
+
+	FChessMoveList LegalMoves;
+	FChessMoveGenerator::GenerateLegalMoves(Position, LegalMoves);
+
+	for (const FChessMove& Move : LegalMoves)
+		if (Move.GetFrom() == From && Move.GetTo() == To && Move.GetPromotionPiece() == PolyglotPromotionPiece[Promotion]) return Move;
+
+	return FChessMove();
+}
+
+uint64 FChessOpeningBook::ReadBigEndian(const uint8* Data, int32 NumBytes)
+{
+	uint64 Value = 0;
+	for (int32 i = 0; i < NumBytes; i++) Value = (Value << 8) | Data[i];
+	return Value;
+}
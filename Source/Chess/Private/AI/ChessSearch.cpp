@@ -0,0 +1,476 @@
+// Copyright Kunal Patil (kroxyserver). All Rights Reserved.
+
+#include "AI/ChessSearch.h"
+
+#include "AI/ChessEvaluation.h"
+#include "AI/ChessMovePicker.h"
+#include "Board/ChessMoveGenerator.h"
+
+#include "HAL/PlatformTime.h"
+#include "Tasks/Task.h"
+
+FChessSearchResult FChessSearch::Search(const FChessPosition& RootPosition, const FChessSearchLimits& Limits, const TArray<uint64>& GameHistory)
+{
+	// Lazy SMP : helpers search the same root and only communicate through the shared transposition table
+	const int32 NumHelpers = TranspositionTable ? FMath::Clamp(Limits.NumThreads, 1, ChessSearch::MaxThreads) - 1 : 0;
+
+	Helpers.Reset();
+
+	TArray<UE::Tasks::FTask> HelperTasks;
+
+	for (int32 i = 0; i < NumHelpers; i++)
+	{
+		FChessSearch& Helper = *Helpers.Add_GetRef(MakeUnique<FChessSearch>());
+		Helper.TranspositionTable = TranspositionTable;
+		Helper.NeuralNetwork = NeuralNetwork;
+		Helper.HelperIndex = i + 1;
+
+		HelperTasks.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION, [&Helper, &RootPosition, &Limits, &GameHistory]()
+		{
+			Helper.IterativeDeepening(RootPosition, Limits, GameHistory);
+		}, UE::Tasks::ETaskPriority::BackgroundHigh));
+	}
+
+	FChessSearchResult Result = IterativeDeepening(RootPosition, Limits, GameHistory);
+
+	// The main thread's answer is the one played, helpers stop as soon as it has one
+	for (TUniquePtr<FChessSearch>& Helper : Helpers) Helper->RequestStop();
+
+	UE::Tasks::Wait(HelperTasks);
+
+	for (const TUniquePtr<FChessSearch>& Helper : Helpers)
+	{
+		Result.Nodes += Helper->Nodes;
+		Result.TranspositionStats += Helper->TranspositionStats;
+		Result.QuiescenceStats += Helper->QuiescenceStats;
+		Result.OrderingStats += Helper->OrderingStats;
+	}
+
+	Helpers.Reset();
+
+	return Result;
+}
+
+FChessSearchResult FChessSearch::IterativeDeepening(const FChessPosition& RootPosition, const FChessSearchLimits& Limits, const TArray<uint64>& GameHistory)
+{
+	Position = RootPosition;
+
+	KeyHistory = GameHistory;
+	if (KeyHistory.Num() == 0 || KeyHistory.Last() != Position.GetKey()) KeyHistory.Add(Position.GetKey());
+	RootHistoryIndex = KeyHistory.Num() - 1;
+	KeyHistory.SetNumZeroed(RootHistoryIndex + ChessSearch::MaxPly);
+
+	Nodes = 0;
+	TranspositionStats = FChessTranspositionStats();
+	QuiescenceStats = FChessQuiescenceStats();
+	OrderingStats = FChessMoveOrderingStats();
+	bStopped = false;
+	PreviousPrincipalVariation.Reset();
+
+	History.Clear();
+	FMemory::Memzero(Killers);
+	FMemory::Memzero(CounterMoves);
+
+	if (NeuralNetwork)
+	{
+		Accumulators.SetNum(ChessSearch::MaxPly + 1);
+		NeuralNetwork->RefreshAccumulator(Position, Accumulators[0]);
+	}
+
+	StartTime = FPlatformTime::Seconds();
+
+	TimeManager = FChessTimeManager();
+	if (HelperIndex == 0) TimeManager.Initialize(Limits, Position);
+
+	bPondering = Limits.bPonder && HelperIndex == 0;
+
+	FChessSearchResult Result;
+
+	// Fallback in case not even depth 1 finishes in time
+	FChessMoveList RootMoves;
+	FChessMoveGenerator::GenerateLegalMoves(Position, RootMoves);
+	if (RootMoves.Num == 0) return Result;
+	Result.BestMove = RootMoves[0];
+
+	const int32 MaxDepth = FMath::Clamp(Limits.MaxDepth, 1, ChessSearch::MaxPly - 1);
+
+	// Helpers only ever help with the best line
+	const int32 NumLines = (HelperIndex == 0) ? FMath::Clamp(Limits.MultiPV, 1, RootMoves.Num) : 1;
+
+	TArray<FChessSearchLine> PreviousLines;
+
+	uint64 PreviousIterationNodes = 0;
+
+	// Iterations in a row that kept the same best move
+	int32 BestMoveStability = 0;
+
+	// Odd helpers start one ply deeper so the threads spread over different depths instead of repeating each other
+	for (int32 Depth = FMath::Min(1 + (HelperIndex & 1), MaxDepth); Depth <= MaxDepth; Depth++)
+	{
+		const uint64 NodesBeforeIteration = Nodes;
+
+		TArray<FChessSearchLine> Lines;
+		ExcludedRootMoves.Reset();
+
+		for (int32 LineIndex = 0; LineIndex < NumLines; LineIndex++)
+		{
+			// Each line follows its own principal variation from the previous iteration
+			bFollowPrincipalVariation = true;
+			PreviousPrincipalVariation = PreviousLines.IsValidIndex(LineIndex) ? PreviousLines[LineIndex].PrincipalVariation : TArray<FChessMove>();
+
+			const int32 LineScore = Negamax(Depth, 0, -ChessSearch::Infinity, ChessSearch::Infinity);
+
+			if (bStopped) break;
+
+			FChessSearchLine& Line = Lines.AddDefaulted_GetRef();
+			Line.Score = LineScore;
+			Line.Depth = Depth;
+
+			for (int32 i = 0; i < PrincipalVariationLength[0]; i++)
+				Line.PrincipalVariation.Add(PrincipalVariation[0][i]);
+
+			if (Line.PrincipalVariation.Num() > 0) ExcludedRootMoves.Add(Line.PrincipalVariation[0]);
+		}
+
+		// A partial iteration isn't trustworthy, keep the last completed one
+		if (bStopped) break;
+
+		// An unstable search can score a later line above an earlier one
+		Lines.StableSort([](const FChessSearchLine& A, const FChessSearchLine& B) { return A.Score > B.Score; });
+
+		const int32 Score = Lines[0].Score;
+
+		// How many times more nodes this depth took than the one before, the better the move ordering the lower it gets
+		const uint64 IterationNodes = Nodes - NodesBeforeIteration;
+		Result.EffectiveBranchingFactor = PreviousIterationNodes ? static_cast<double>(IterationNodes) / PreviousIterationNodes : 0.0;
+		PreviousIterationNodes = IterationNodes;
+
+		// Compared against the previous iteration before Result is overwritten
+		const int32 ScoreDrop = (Result.Depth > 0) ? Result.Score - Score : 0;
+
+		Result.Score = Score;
+		Result.Depth = Depth;
+
+		Result.PrincipalVariation = Lines[0].PrincipalVariation;
+
+		if (Result.PrincipalVariation.Num() > 0)
+		{
+			BestMoveStability = (PreviousLines.Num() > 0 && PreviousLines[0].PrincipalVariation.Num() > 0 && PreviousLines[0].PrincipalVariation[0] == Result.PrincipalVariation[0]) ? BestMoveStability + 1 : 0;
+			Result.BestMove = Result.PrincipalVariation[0];
+		}
+
+		Result.Lines = Lines;
+		PreviousLines = MoveTemp(Lines);
+
+		Result.Nodes = Nodes;
+		Result.ElapsedSeconds = FPlatformTime::Seconds() - StartTime;
+		Result.TranspositionStats = TranspositionStats;
+		Result.QuiescenceStats = QuiescenceStats;
+		Result.OrderingStats = OrderingStats;
+
+		if (OnIterationComplete && HelperIndex == 0) OnIterationComplete(Result);
+
+		// No point searching deeper once a forced mate is found
+		if (ChessSearch::IsMateScore(Score)) break;
+
+		CheckPonderHit();
+
+		// Stop early when the best move has settled, carry on longer when the score is falling
+		if (!bPondering && TimeManager.ShouldStopIteration(BestMoveStability, ScoreDrop)) break;
+	}
+
+	Result.Nodes = Nodes;
+	Result.ElapsedSeconds = FPlatformTime::Seconds() - StartTime;
+	Result.TranspositionStats = TranspositionStats;
+	Result.QuiescenceStats = QuiescenceStats;
+	Result.OrderingStats = OrderingStats;
+
+	return Result;
+}
+
+int32 FChessSearch::Negamax(int32 Depth, int32 Ply, int32 Alpha, int32 Beta)
+{
+	PrincipalVariationLength[Ply] = 0;
+
+	if (ShouldStop()) return 0;
+
+	KeyHistory[RootHistoryIndex + Ply] = Position.GetKey();
+
+	if (Ply > 0 && (Position.GetHalfmoveClock() >= 100 || IsRepetition(Ply))) return 0;
+
+	// Quiescence counts its own nodes
+	if (Depth <= 0) return Quiescence(Ply, Alpha, Beta);
+
+	Nodes++;
+
+	if (Ply >= ChessSearch::MaxPly - 1) return Evaluate(Ply);
+
+	FChessMove TableMove;
+
+	if (TranspositionTable)
+	{
+		FChessTranspositionEntry Entry;
+		if (TranspositionTable->Probe(Position.GetKey(), Ply, Entry, TranspositionStats))
+		{
+			TableMove = Entry.BestMove;
+
+			// Never cut at the root, the move played has to come from this search
+			if (Ply > 0 && Entry.Depth >= Depth)
+			{
+				if (Entry.Bound == EChessBound::Exact) return Entry.Score;
+				if (Entry.Bound == EChessBound::Lower && Entry.Score >= Beta) return Entry.Score;
+				if (Entry.Bound == EChessBound::Upper && Entry.Score <= Alpha) return Entry.Score;
+			}
+		}
+	}
+
+	// The previous principal variation overrides the hash move while still on that line
+	const FChessMove PrincipalVariationMove = GetPrincipalVariationMove(Ply);
+
+	const FChessMove PreviousMove = (Ply > 0) ? MoveStack[Ply - 1] : FChessMove();
+	const FChessMove CounterMove = PreviousMove.IsValid() ? CounterMoves[PreviousMove.GetFrom()][PreviousMove.GetTo()] : FChessMove();
+
+	FChessMovePicker Picker(Position, PrincipalVariationMove.IsValid() ? PrincipalVariationMove : TableMove, Killers[Ply], CounterMove, History);
+
+	const int32 OriginalAlpha = Alpha;
+	int32 BestScore = -ChessSearch::Infinity;
+	FChessMove BestMove;
+
+	// Quiet moves that didn't cut off, they lose history if a later one does
+	FChessMoveList QuietsSearched;
+	int32 NumMovesSearched = 0;
+
+	for (FChessMove Move = Picker.Next(); Move.IsValid(); Move = Picker.Next())
+	{
+		// Taken by an earlier line, and the principal variation below it is no use to the others
+		if (Ply == 0 && ExcludedRootMoves.Contains(Move))
+		{
+			bFollowPrincipalVariation = false;
+			continue;
+		}
+
+		if (NeuralNetwork) NeuralNetwork->UpdateAccumulator(Accumulators[Ply], Accumulators[Ply + 1], Position, Move);
+
+		MoveStack[Ply] = Move;
+
+		FChessUndoInfo Undo;
+		Position.MakeMove(Move, Undo);
+		const int32 Score = -Negamax(Depth - 1, Ply + 1, -Beta, -Alpha);
+		Position.UnmakeMove(Move, Undo);
+
+		NumMovesSearched++;
+
+		// only the first move searched can be on the previous principal variation
+		bFollowPrincipalVariation = false;
+
+		if (bStopped) return 0;
+
+		if (Score > BestScore)
+		{
+			BestScore = Score;
+
+			if (Score > Alpha)
+			{
+				Alpha = Score;
+				BestMove = Move;
+				UpdatePrincipalVariation(Move, Ply);
+
+				if (Alpha >= Beta)
+				{
+					OrderingStats.BetaCutoffs++;
+					if (NumMovesSearched == 1) OrderingStats.FirstMoveCutoffs++;
+
+					if (Move.IsQuiet()) UpdateQuietMoveOrdering(Move, QuietsSearched, PreviousMove, Depth, Ply);
+
+					break;
+				}
+			}
+		}
+
+		if (Move.IsQuiet()) QuietsSearched.Add(Move);
+	}
+
+	// Checkmate or stalemate
+	if (NumMovesSearched == 0) return Position.IsInCheck() ? -ChessSearch::MateScore + Ply : 0;
+
+	// With root moves excluded the root's best move isn't its real one, so it stays out of the table
+	if (TranspositionTable && (Ply > 0 || ExcludedRootMoves.Num == 0))
+	{
+		const EChessBound::Type Bound = (BestScore >= Beta) ? EChessBound::Lower : (BestScore > OriginalAlpha) ? EChessBound::Exact : EChessBound::Upper;
+		TranspositionTable->Store(Position.GetKey(), Ply, BestMove, BestScore, Depth, Bound, TranspositionStats);
+	}
+
+	return BestScore;
+}
+
+int32 FChessSearch::Quiescence(int32 Ply, int32 Alpha, int32 Beta)
+{
+	PrincipalVariationLength[Ply] = 0;
+
+	if (ShouldStop()) return 0;
+
+	Nodes++;
+	QuiescenceStats.Nodes++;
+
+	if (Ply >= ChessSearch::MaxPly - 1) return Evaluate(Ply);
+
+	const bool bInCheck = Position.IsInCheck();
+
+	FChessMoveList Moves;
+	int32 BestScore = -ChessSearch::Infinity;
+
+	if (bInCheck)
+	{
+		// Standing pat isn't an option in check, every evasion has to be tried
+		FChessMoveGenerator::GenerateLegalMoves(Position, Moves);
+		if (Moves.Num == 0) return -ChessSearch::MateScore + Ply;
+	}
+	else
+	{
+		// The side to move can usually do at least as well as the static evaluation by not capturing at all
+		BestScore = Evaluate(Ply);
+
+		if (BestScore >= Beta)
+		{
+			QuiescenceStats.StandPatCutoffs++;
+			return BestScore;
+		}
+
+		Alpha = FMath::Max(Alpha, BestScore);
+
+		FChessMoveGenerator::GenerateLegalCaptures(Position, Moves);
+	}
+
+	int32 MoveScores[FChessMoveList::MaxMoves];
+	for (int32 i = 0; i < Moves.Num; i++) MoveScores[i] = ChessMoveOrdering::GetCaptureScore(Position, Moves[i]);
+
+	for (int32 i = 0; i < Moves.Num; i++)
+	{
+		// Selection sort one move at a time, a cutoff usually comes before the list is exhausted
+		int32 BestIndex = i;
+		for (int32 j = i + 1; j < Moves.Num; j++)
+			if (MoveScores[j] > MoveScores[BestIndex]) BestIndex = j;
+
+		Swap(Moves[i], Moves[BestIndex]);
+		Swap(MoveScores[i], MoveScores[BestIndex]);
+
+		const FChessMove Move = Moves[i];
+
+		if (!bInCheck)
+		{
+			// Underpromotions almost never matter this deep and would multiply the tree by four
+			if (Move.IsPromotion() && Move.GetPromotionPiece() != EChessPiece::Queen) continue;
+
+			if (FChessEvaluation::StaticExchange(Position, Move) < 0)
+			{
+				QuiescenceStats.PrunedCaptures++;
+				continue;
+			}
+		}
+
+		if (NeuralNetwork) NeuralNetwork->UpdateAccumulator(Accumulators[Ply], Accumulators[Ply + 1], Position, Move);
+
+		FChessUndoInfo Undo;
+		Position.MakeMove(Move, Undo);
+		const int32 Score = -Quiescence(Ply + 1, -Beta, -Alpha);
+		Position.UnmakeMove(Move, Undo);
+
+		if (bStopped) return 0;
+
+		if (Score > BestScore)
+		{
+			BestScore = Score;
+
+			if (Score > Alpha)
+			{
+				Alpha = Score;
+				UpdatePrincipalVariation(Move, Ply);
+
+				if (Alpha >= Beta) break;
+			}
+		}
+	}
+
+	return BestScore;
+}
+
+int32 FChessSearch::Evaluate(int32 Ply) const
+{
+	return NeuralNetwork ? NeuralNetwork->Evaluate(Accumulators[Ply], Position.GetSideToMove()) : FChessEvaluation::Evaluate(Position);
+}
+
+FChessMove FChessSearch::GetPrincipalVariationMove(int32 Ply)
+{
+	if (!bFollowPrincipalVariation) return FChessMove();
+
+	if (!PreviousPrincipalVariation.IsValidIndex(Ply))
+	{
+		bFollowPrincipalVariation = false;
+		return FChessMove();
+	}
+
+	return PreviousPrincipalVariation[Ply];
+}
+
+void FChessSearch::UpdateQuietMoveOrdering(FChessMove Move, const FChessMoveList& QuietsSearched, FChessMove PreviousMove, int32 Depth, int32 Ply)
+{
+	if (Killers[Ply][0] != Move)
+	{
+		Killers[Ply][1] = Killers[Ply][0];
+		Killers[Ply][0] = Move;
+	}
+
+	if (PreviousMove.IsValid()) CounterMoves[PreviousMove.GetFrom()][PreviousMove.GetTo()] = Move;
+
+	// Deeper cutoffs say more about a move, the cap keeps one deep result from swamping the table
+	const int32 Bonus = FMath::Min(Depth * Depth, 400);
+	const EChessColour::Type Us = Position.GetSideToMove();
+
+	History.Update(Us, Move, Bonus);
+
+	for (const FChessMove& Quiet : QuietsSearched)
+		History.Update(Us, Quiet, -Bonus);
+}
+
+void FChessSearch::UpdatePrincipalVariation(FChessMove Move, int32 Ply)
+{
+	PrincipalVariation[Ply][0] = Move;
+
+	for (int32 i = 0; i < PrincipalVariationLength[Ply + 1]; i++)
+		PrincipalVariation[Ply][i + 1] = PrincipalVariation[Ply + 1][i];
+
+	PrincipalVariationLength[Ply] = PrincipalVariationLength[Ply + 1] + 1;
+}
+
+bool FChessSearch::IsRepetition(int32 Ply) const
+{
+	const int32 Current = RootHistoryIndex + Ply;
+	const int32 Oldest = FMath::Max(0, Current - Position.GetHalfmoveClock());
+
+	for (int32 i = Current - 2; i >= Oldest; i -= 2)
+		if (KeyHistory[i] == KeyHistory[Current]) return true;
+
+	return false;
+}
+
+bool FChessSearch::ShouldStop()
+{
+	if (bStopped) return true;
+
+	// Reading the clock every node is measurable, every 2048 nodes is plenty responsive
+	if ((Nodes & 2047) != 0) return false;
+
+	CheckPonderHit();
+
+	if (bStopRequested.load(std::memory_order_relaxed) || (!bPondering && TimeManager.IsOutOfTime())) bStopped = true;
+
+	return bStopped;
+}
+
+void FChessSearch::CheckPonderHit()
+{
+	if (!bPondering || !bPonderHitRequested.load(std::memory_order_relaxed)) return;
+
+	bPondering = false;
+	TimeManager.Start();
+}
@@ -0,0 +1,71 @@
+// Copyright Kunal Patil (kroxyserver). All Rights Reserved.
+
+#include "AI/ChessTimeManager.h"
+
+#include "AI/ChessSearch.h"
+#include "Board/ChessPosition.h"
+
+namespace
+{
+	// Kept back from every budget for the move to reach the board, running out of time loses the game
+	constexpr double MoveOverheadSeconds = 0.05;
+
+	// Sudden death has no move count, so assume the game runs to about this move and never plan for fewer than MinMovesLeft more
+	constexpr int32 ExpectedGameLength = 60;
+
+	constexpr int32 MinMovesLeft = 20;
+
+	constexpr int32 MaxMovesLeft = 50;
+
+	// Share of the increment spent on this move, the rest builds a reserve
+	constexpr double IncrementShare = 0.75;
+
+	// A single move may use up to this many optimums, but never more than MaxClockShare of what is left
+	constexpr double MaxOptimumScale = 5.0;
+
+	constexpr double MaxClockShare = 0.75;
+
+	// An iteration usually takes a few times longer than the one before, so a new one only starts in the first part of the budget
+	constexpr double NewIterationShare = 0.5;
+}
+
+void FChessTimeManager::Initialize(const FChessSearchLimits& Limits, const FChessPosition& RootPosition)
+{
+	OptimumSeconds = 0.0;
+	MaximumSeconds = Limits.MaxTimeSeconds;
+
+	if (Limits.ClockSeconds > 0.0)
+	{
+		const double Available = FMath::Max(Limits.ClockSeconds - MoveOverheadSeconds, 0.01);
+
+		const int32 MovesLeft = (Limits.MovesToGo > 0) ? Limits.MovesToGo : FMath::Clamp(ExpectedGameLength - RootPosition.GetFullmoveNumber(), MinMovesLeft, MaxMovesLeft);
+
+		const double Optimum = Available / MovesLeft + IncrementShare * Limits.IncrementSeconds;
+
+		double Maximum = FMath::Min(Optimum * MaxOptimumScale, Available * MaxClockShare);
+		if (MaximumSeconds > 0.0) Maximum = FMath::Min(Maximum, MaximumSeconds);
+
+		MaximumSeconds = Maximum;
+		OptimumSeconds = FMath::Min(Optimum, Maximum);
+	}
+
+	Start();
+}
+
+void FChessTimeManager::Start()
+{
+	StartTime = FPlatformTime::Seconds();
+}
+
+bool FChessTimeManager::ShouldStopIteration(int32 BestMoveStability, int32 ScoreDrop) const
+{
+	if (OptimumSeconds <= 0.0) return false;
+
+	// A best move that keeps coming back needs less confirming, a new one needs more
+	const double StabilityScale = 1.25 - 0.1 * FMath::Min(BestMoveStability, 6);
+
+	// A falling score means trouble the search hasn't got to the bottom of yet, up to twice the time to find a way out
+	const double ScoreDropScale = FMath::Clamp(1.0 + ScoreDrop / 100.0, 1.0, 2.0);
+
+	return GetElapsedSeconds() >= NewIterationShare * FMath::Min(OptimumSeconds * StabilityScale * ScoreDropScale, MaximumSeconds);
+}
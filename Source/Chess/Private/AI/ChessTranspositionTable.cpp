@@ -0,0 +1,161 @@
+// Copyright Kunal Patil (kroxyserver). All Rights Reserved.
+
+#include "AI/ChessTranspositionTable.h"
+
+#include "AI/ChessSearch.h"
+
+namespace
+{
+	// Data layout : Move 16 | Score 16 | Depth 8 | Bound 2 | Generation 6
+	FORCEINLINE uint64 PackData(FChessMove Move, int32 Score, int32 Depth, EChessBound::Type Bound, uint8 Generation)
+	{
+		return static_cast<uint64>(Move.Data)
+			| (static_cast<uint64>(static_cast<uint16>(static_cast<int16>(Score))) << 16)
+			| (static_cast<uint64>(static_cast<uint8>(FMath::Clamp(Depth, 0, 255))) << 32)
+			| (static_cast<uint64>(Bound) << 40)
+			| (static_cast<uint64>(Generation) << 42);
+	}
+
+	FORCEINLINE FChessMove GetMove(uint64 Data) { FChessMove Move; Move.Data = static_cast<uint16>(Data); return Move; }
+	FORCEINLINE int32 GetScore(uint64 Data) { return static_cast<int16>(static_cast<uint16>(Data >> 16)); }
+	FORCEINLINE int32 GetDepth(uint64 Data) { return static_cast<uint8>(Data >> 32); }
+	FORCEINLINE EChessBound::Type GetBound(uint64 Data) { return static_cast<EChessBound::Type>((Data >> 40) & 3); }
+	FORCEINLINE uint8 GetGeneration(uint64 Data) { return static_cast<uint8>(Data >> 42); }
+
+	// Mate scores are stored relative to the node so they stay correct wherever the position is reached from
+	FORCEINLINE int32 ScoreToTable(int32 Score, int32 Ply)
+	{
+		if (Score >= ChessSearch::MateThreshold) return Score + Ply;
+		if (Score <= -ChessSearch::MateThreshold) return Score - Ply;
+		return Score;
+	}
+
+	FORCEINLINE int32 ScoreFromTable(int32 Score, int32 Ply)
+	{
+		if (Score >= ChessSearch::MateThreshold) return Score - Ply;
+		if (Score <= -ChessSearch::MateThreshold) return Score + Ply;
+		return Score;
+	}
+}
+
+FChessTranspositionTable::FChessTranspositionTable(int32 SizeInMegabytes)
+{
+	Resize(SizeInMegabytes);
+}
+
+void FChessTranspositionTable::Resize(int32 SizeInMegabytes)
+{
+	// Power of two cluster count so the index is a mask
+	const uint64 RequestedClusters = FMath::Max<uint64>(1, (static_cast<uint64>(FMath::Max(SizeInMegabytes, 1)) << 20) / sizeof(FCluster));
+
+	NumClusters = 1;
+	while (NumClusters * 2 <= RequestedClusters) NumClusters *= 2;
+
+	Clusters = MakeUnique<FCluster[]>(NumClusters);
+}
+
+void FChessTranspositionTable::Clear()
+{
+	for (uint64 i = 0; i < NumClusters; i++)
+	{
+		for (FSlot& Slot : Clusters[i].Slots)
+		{
+			Slot.KeyXorData.store(0, std::memory_order_relaxed);
+			Slot.Data.store(0, std::memory_order_relaxed);
+		}
+	}
+
+	Generation.store(0, std::memory_order_relaxed);
+}
+
+bool FChessTranspositionTable::Probe(uint64 Key, int32 Ply, FChessTranspositionEntry& OutEntry, FChessTranspositionStats& Stats) const
+{
+	Stats.Probes++;
+
+	const FCluster& Cluster = Clusters[Key & (NumClusters - 1)];
+
+	for (const FSlot& Slot : Cluster.Slots)
+	{
+		const uint64 Data = Slot.Data.load(std::memory_order_relaxed);
+		const uint64 KeyXorData = Slot.KeyXorData.load(std::memory_order_relaxed);
+
+		if ((KeyXorData ^ Data) != Key || GetBound(Data) == EChessBound::None) continue;
+
+		OutEntry.BestMove = GetMove(Data);
+		OutEntry.Score = ScoreFromTable(GetScore(Data), Ply);
+		OutEntry.Depth = GetDepth(Data);
+		OutEntry.Bound = GetBound(Data);
+
+		Stats.Hits++;
+		return true;
+	}
+
+	return false;
+}
+
+void FChessTranspositionTable::Store(uint64 Key, int32 Ply, FChessMove BestMove, int32 Score, int32 Depth, EChessBound::Type Bound, FChessTranspositionStats& Stats)
+{
+	FCluster& Cluster = Clusters[Key & (NumClusters - 1)];
+
+	const uint8 CurrentGeneration = Generation.load(std::memory_order_relaxed);
+
+	FSlot* Replace = nullptr;
+	uint64 ReplaceData = 0;
+	int32 ReplaceWorth = TNumericLimits<int32>::Max();
+
+	for (FSlot& Slot : Cluster.Slots)
+	{
+		const uint64 Data = Slot.Data.load(std::memory_order_relaxed);
+
+		// Same position : keep the deeper result unless this one is exact
+		if ((Slot.KeyXorData.load(std::memory_order_relaxed) ^ Data) == Key && GetBound(Data) != EChessBound::None)
+		{
+			if (Bound != EChessBound::Exact && Depth + 2 < GetDepth(Data) && GetGeneration(Data) == CurrentGeneration) return;
+
+			// a fail low has no best move, keep the one already known
+			if (!BestMove.IsValid()) BestMove = GetMove(Data);
+
+			Replace = &Slot;
+			ReplaceData = 0;
+			break;
+		}
+
+		// Otherwise evict the shallowest entry, older searches count as shallower
+		const int32 Age = (CurrentGeneration - GetGeneration(Data)) & GenerationMask;
+		const int32 Worth = (GetBound(Data) == EChessBound::None) ? TNumericLimits<int32>::Min() : GetDepth(Data) - 8 * Age;
+
+		if (Worth < ReplaceWorth)
+		{
+			Replace = &Slot;
+			ReplaceData = Data;
+			ReplaceWorth = Worth;
+		}
+	}
+
+	if (GetBound(ReplaceData) != EChessBound::None) Stats.Collisions++;
+	Stats.Stores++;
+
+	const uint64 Data = PackData(BestMove, ScoreToTable(Score, Ply), Depth, Bound, CurrentGeneration);
+
+	Replace->KeyXorData.store(Key ^ Data, std::memory_order_relaxed);
+	Replace->Data.store(Data, std::memory_order_relaxed);
+}
+
+int32 FChessTranspositionTable::GetHashfull() const
+{
+	const uint8 CurrentGeneration = Generation.load(std::memory_order_relaxed);
+	const uint64 SampleClusters = FMath::Min<uint64>(NumClusters, 250);
+
+	int32 Used = 0;
+
+	for (uint64 i = 0; i < SampleClusters; i++)
+	{
+		for (const FSlot& Slot : Clusters[i].Slots)
+		{
+			const uint64 Data = Slot.Data.load(std::memory_order_relaxed);
+			if (GetBound(Data) != EChessBound::None && GetGeneration(Data) == CurrentGeneration) Used++;
+		}
+	}
+
+	return static_cast<int32>(Used * 1000 / (SampleClusters * EntriesPerCluster));
+}
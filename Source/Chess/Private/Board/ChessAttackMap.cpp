@@ -0,0 +1,102 @@
+// Copyright Kunal Patil (kroxyserver). All Rights Reserved.
+
+#include "Board/ChessAttackMap.h"
+
+#include "Board/ChessPosition.h"
+
+FChessAttackMap::FChessAttackMap()
+{
+	FMemory::Memzero(SquareAttacks, sizeof(SquareAttacks));
+	FMemory::Memzero(ColourAttacks, sizeof(ColourAttacks));
+	FMemory::Memzero(PieceBitboards, sizeof(PieceBitboards));
+
+	ChangedSquares = 0;
+	NumPiecesUpdated = 0;
+}
+
+void FChessAttackMap::Reset(const FChessPosition& Position)
+{
+	for (int32 Colour = 0; Colour < EChessColour::Num; Colour++)
+		for (int32 Piece = 0; Piece < EChessPiece::Num; Piece++)
+			PieceBitboards[Colour][Piece] = Position.GetPieces(static_cast<EChessColour::Type>(Colour), static_cast<EChessPiece::Type>(Piece));
+
+	for (int32 Square = 0; Square < 64; Square++)
+		SquareAttacks[Square] = ComputePieceAttacks(Position, Square);
+
+	ChangedSquares = Position.GetOccupied();
+	NumPiecesUpdated = ChessBitboard::CountBits(Position.GetOccupied());
+
+	RebuildColourAttacks();
+}
+
+void FChessAttackMap::Update(const FChessPosition& Position)
+{
+	ChangedSquares = 0;
+	NumPiecesUpdated = 0;
+
+	for (int32 Colour = 0; Colour < EChessColour::Num; Colour++)
+	{
+		for (int32 Piece = 0; Piece < EChessPiece::Num; Piece++)
+		{
+			const uint64 Current = Position.GetPieces(static_cast<EChessColour::Type>(Colour), static_cast<EChessPiece::Type>(Piece));
+			ChangedSquares |= PieceBitboards[Colour][Piece] ^ Current;
+			PieceBitboards[Colour][Piece] = Current;
+		}
+	}
+
+	if (!ChangedSquares) return;
+
+	// A slider only needs its ray recomputed when a square it reaches was vacated or filled, including the opponent king moving on or off it
+	uint64 Dirty = ChangedSquares;
+
+	for (uint64 Sliders = Position.GetPieces(EChessPiece::Queen) | Position.GetPieces(EChessPiece::Rook) | Position.GetPieces(EChessPiece::Bishop); Sliders;)
+	{
+		const int32 Square = ChessBitboard::PopLeastSignificantSquare(Sliders);
+		if (SquareAttacks[Square] & ChangedSquares) Dirty |= ChessBitboard::SquareMask(Square);
+	}
+
+	while (Dirty)
+	{
+		const int32 Square = ChessBitboard::PopLeastSignificantSquare(Dirty);
+		SquareAttacks[Square] = ComputePieceAttacks(Position, Square);
+
+		if (Position.GetOccupied() & ChessBitboard::SquareMask(Square)) NumPiecesUpdated++;
+	}
+
+	RebuildColourAttacks();
+}
+
+uint64 FChessAttackMap::ComputePieceAttacks(const FChessPosition& Position, int32 Square) const
+{
+	EChessColour::Type Colour;
+	EChessPiece::Type Piece;
+	if (!Position.GetPieceOnSquare(Square, Colour, Piece)) return 0;
+
+	const uint64 Occupied = Position.GetOccupied() & ~Position.GetPieces(EChessColour::GetOpposite(Colour), EChessPiece::King);
+
+	switch (Piece)
+	{
+	case EChessPiece::King:		return ChessBitboard::GetKingAttacks(Square);
+	case EChessPiece::Queen:	return ChessBitboard::GetQueenAttacks(Square, Occupied);
+	case EChessPiece::Bishop:	return ChessBitboard::GetBishopAttacks(Square, Occupied);
+	case EChessPiece::Knight:	return ChessBitboard::GetKnightAttacks(Square);
+	case EChessPiece::Rook:		return ChessBitboard::GetRookAttacks(Square, Occupied);
+	case EChessPiece::Pawn:		return ChessBitboard::GetPawnAttacks(Colour == EChessColour::White, Square);
+	default:					return 0;
+	}
+}
+
+void FChessAttackMap::RebuildColourAttacks()
+{
+	// At most 16 pieces a side, cheaper than keeping per square attacker counts up to date
+	for (int32 Colour = 0; Colour < EChessColour::Num; Colour++)
+	{
+		uint64 Attacks = 0;
+
+		for (int32 Piece = 0; Piece < EChessPiece::Num; Piece++)
+			for (uint64 Pieces = PieceBitboards[Colour][Piece]; Pieces;)
+				Attacks |= SquareAttacks[ChessBitboard::PopLeastSignificantSquare(Pieces)];
+
+		ColourAttacks[Colour] = Attacks;
+	}
+}
@@ -0,0 +1,191 @@
+// Copyright Kunal Patil (kroxyserver). All Rights Reserved.
+
+#include "Board/ChessBitboard.h"
+
+namespace ChessBitboard
+{
+	namespace Tables
+	{
+		uint64 KnightAttacks[64];
+		uint64 KingAttacks[64];
+		uint64 PawnAttacks[2][64];
+		FSliderMagic RookMagics[64];
+		FSliderMagic BishopMagics[64];
+		uint64 Between[64][64];
+		uint64 Line[64][64];
+
+		// Sum of 2^(relevant occupancy bits) over all squares
+		static uint64 RookAttackTable[102400];
+		static uint64 BishopAttackTable[5248];
+	}
+
+	static const int32 RookDirections[4][2] = { { 1, 0 }, { 0, 1 }, { -1, 0 }, { 0, -1 } };
+	static const int32 BishopDirections[4][2] = { { 1, -1 }, { 1, 1 }, { -1, 1 }, { -1, -1 } };
+
+	// Reference ray walk, only used while building the tables
+	static uint64 SlideAlongDirections(int32 Square, uint64 Occupied, const int32 (&Directions)[4][2])
+	{
+		uint64 Attacks = Empty;
+
+		for (const int32 (&Direction)[2] : Directions)
+		{
+			int32 Rank = GetRank(Square) + Direction[0];
+			int32 File = GetFile(Square) + Direction[1];
+
+			while (Rank >= 0 && Rank < 8 && File >= 0 && File < 8)
+			{
+				const uint64 Mask = SquareMask(MakeSquare(Rank, File));
+				Attacks |= Mask;
+
+				// stop at the first piece on the ray
+				if (Occupied & Mask) break;
+
+				Rank += Direction[0];
+				File += Direction[1];
+			}
+		}
+
+		return Attacks;
+	}
+
+	// Deterministic xorshift so the magics found are identical on every run
+	struct FMagicRandom
+	{
+		uint64 State;
+
+		explicit FMagicRandom(uint64 Seed) : State(Seed) {}
+
+		uint64 Next()
+		{
+			State ^= State >> 12;
+			State ^= State << 25;
+			State ^= State >> 27;
+			return State * 0x2545F4914F6CDD1DULL;
+		}
+
+		uint64 NextSparse() { return Next() & Next() & Next(); }
+	};
+
+	static void InitializeSliderMagics(FSliderMagic (&Magics)[64], uint64* AttackTable, const int32 (&Directions)[4][2])
+	{
+		// Per rank seeds known to converge quickly for this generator
+		static const uint64 RankSeeds[8] = { 728, 10316, 55013, 32803, 12281, 15100, 16645, 255 };
+
+		uint64 Occupancies[4096];
+		uint64 ReferenceAttacks[4096];
+		int32 Epoch[4096] = {};
+		int32 CurrentEpoch = 0;
+
+		uint64* NextAttacks = AttackTable;
+
+		for (int32 Square = 0; Square < 64; Square++)
+		{
+			// Board edges never block a ray so they are left out of the relevant occupancy
+			const uint64 Edges = ((Rank1 | Rank8) & ~(Rank1 << (8 * GetRank(Square)))) | ((FileA | FileH) & ~(FileA << GetFile(Square)));
+
+			FSliderMagic& Magic = Magics[Square];
+			Magic.Mask = SlideAlongDirections(Square, Empty, Directions) & ~Edges;
+			Magic.Shift = 64 - CountBits(Magic.Mask);
+			Magic.Attacks = NextAttacks;
+
+			// Enumerate all subsets of the mask (Carry-Rippler)
+			int32 Size = 0;
+			uint64 Occupied = 0;
+			do
+			{
+				Occupancies[Size] = Occupied;
+				ReferenceAttacks[Size] = SlideAlongDirections(Square, Occupied, Directions);
+				Size++;
+				Occupied = (Occupied - Magic.Mask) & Magic.Mask;
+			} while (Occupied);
+
+			NextAttacks += Size;
+
+#if CHESS_USE_PEXT
+			for (int32 i = 0; i < Size; i++)
+				Magic.Attacks[Magic.GetIndex(Occupancies[i])] = ReferenceAttacks[i];
+#else
+			// Search for a multiplier that maps every subset without destructive collisions
+			FMagicRandom Random(RankSeeds[GetRank(Square)]);
+
+			for (int32 i = 0; i < Size;)
+			{
+				do
+				{
+					Magic.Magic = Random.NextSparse();
+				} while (CountBits((Magic.Mask * Magic.Magic) >> 56) < 6);
+
+				CurrentEpoch++;
+
+				for (i = 0; i < Size; i++)
+				{
+					const uint32 Index = Magic.GetIndex(Occupancies[i]);
+
+					if (Epoch[Index] < CurrentEpoch)
+					{
+						Epoch[Index] = CurrentEpoch;
+						Magic.Attacks[Index] = ReferenceAttacks[i];
+					}
+					else if (Magic.Attacks[Index] != ReferenceAttacks[i])
+					{
+						break;
+					}
+				}
+			}
+#endif
+		}
+	}
+
+	void InitializeAttackTables()
+	{
+		for (int32 Square = 0; Square < 64; Square++)
+		{
+			const uint64 Mask = SquareMask(Square);
+
+			// Knight
+			const uint64 East1 = (Mask & ~FileH) << 1;
+			const uint64 East2 = (Mask & ~(FileG | FileH)) << 2;
+			const uint64 West1 = (Mask & ~FileA) >> 1;
+			const uint64 West2 = (Mask & ~(FileA | FileB)) >> 2;
+			const uint64 OneFile = East1 | West1;
+			const uint64 TwoFiles = East2 | West2;
+			Tables::KnightAttacks[Square] = (OneFile << 16) | (OneFile >> 16) | (TwoFiles << 8) | (TwoFiles >> 8);
+
+			// King
+			const uint64 Row = Mask | ShiftEast(Mask) | ShiftWest(Mask);
+			Tables::KingAttacks[Square] = (Row | ShiftNorth(Row) | ShiftSouth(Row)) & ~Mask;
+
+			// Pawns
+			Tables::PawnAttacks[0][Square] = ShiftEast(ShiftNorth(Mask)) | ShiftWest(ShiftNorth(Mask));
+			Tables::PawnAttacks[1][Square] = ShiftEast(ShiftSouth(Mask)) | ShiftWest(ShiftSouth(Mask));
+		}
+
+		InitializeSliderMagics(Tables::RookMagics, Tables::RookAttackTable, RookDirections);
+		InitializeSliderMagics(Tables::BishopMagics, Tables::BishopAttackTable, BishopDirections);
+
+		for (int32 SquareA = 0; SquareA < 64; SquareA++)
+		{
+			for (int32 SquareB = 0; SquareB < 64; SquareB++)
+			{
+				Tables::Between[SquareA][SquareB] = Empty;
+				Tables::Line[SquareA][SquareB] = Empty;
+
+				if (SquareA == SquareB) continue;
+
+				const uint64 MaskA = SquareMask(SquareA);
+				const uint64 MaskB = SquareMask(SquareB);
+
+				if (GetRookAttacks(SquareA, Empty) & MaskB)
+				{
+					Tables::Between[SquareA][SquareB] = GetRookAttacks(SquareA, MaskB) & GetRookAttacks(SquareB, MaskA);
+					Tables::Line[SquareA][SquareB] = (GetRookAttacks(SquareA, Empty) & GetRookAttacks(SquareB, Empty)) | MaskA | MaskB;
+				}
+				else if (GetBishopAttacks(SquareA, Empty) & MaskB)
+				{
+					Tables::Between[SquareA][SquareB] = GetBishopAttacks(SquareA, MaskB) & GetBishopAttacks(SquareB, MaskA);
+					Tables::Line[SquareA][SquareB] = (GetBishopAttacks(SquareA, Empty) & GetBishopAttacks(SquareB, Empty)) | MaskA | MaskB;
+				}
+			}
+		}
+	}
+}
@@ -2,26 +2,82 @@
 
 #include "Board/ChessBoard.h"
 
+#include "Chess/Chess.h"
+
+#include "Board/ChessMoveGenerator.h"
 #include "Board/ChessPiece.h"
 #include "Board/ChessTile.h"
 #include "Core/ChessGameMode.h"
 #include "Core/ChessPlayerController.h"
 #include "Data/ChessBoardData.h"
 
+#include "Components/InstancedStaticMeshComponent.h"
 #include "Kismet/GameplayStatics.h"
 
 #define PRINTSTRING(Colour, DebugMessage) GEngine->AddOnScreenDebugMessage(INDEX_NONE, 3.f, Colour, DebugMessage);
 
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Boards"), STAT_ChessBoards, STATGROUP_Chess);
+
+namespace
+{
+	// Looks a tile can have, one tile instance component each
+	namespace EChessTileLook
+	{
+		enum Type : int32
+		{
+			White,
+			Black,
+			Highlighted,
+			Num
+		};
+	}
+
+	FORCEINLINE int32 GetChessTileInstancesIndex(bool bIsWhite, bool bIsHighlighted)
+	{
+		return bIsHighlighted ? EChessTileLook::Highlighted : (bIsWhite ? EChessTileLook::White : EChessTileLook::Black);
+	}
+
+	FORCEINLINE int32 GetChessPieceInstancesIndex(bool bIsWhite, EChessPieceType ChessPieceType)
+	{
+		return EChessColour::FromIsWhite(bIsWhite) * EChessPiece::Num + static_cast<int32>(ChessPieceType);
+	}
+}
+
 AChessBoard::AChessBoard() :
 	ChessTileClass(AChessTile::StaticClass()),
 	ChessPieceClass(AChessPiece::StaticClass())
 {
-	PrimaryActorTick.bCanEverTick = true;
+	// Everything on the board changes in response to a move, nothing needs a frame update
+	PrimaryActorTick.bCanEverTick = false;
 
 	// DefaultSceneRootComponent
 	DefaultSceneRootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("DefaultSceneRootComponent"));
 	SetRootComponent(DefaultSceneRootComponent);
 
+	// ChessTileInstances
+	static ConstructorHelpers::FObjectFinder<UStaticMesh> ChessTileMeshAsset(TEXT("/Script/Engine.StaticMesh'/Game/Assets/Meshes/SM_ChessTile.SM_ChessTile'"));
+
+	for (int32 i = 0; i < EChessTileLook::Num; i++)
+	{
+		UInstancedStaticMeshComponent* Instances = CreateDefaultSubobject<UInstancedStaticMeshComponent>(FName(TEXT("ChessTileInstances"), i));
+		Instances->SetupAttachment(DefaultSceneRootComponent);
+		Instances->SetCollisionProfileName("ChessTile"); // zero scale instances get no body, so a trace only hits a tile where it is shown
+		if (ChessTileMeshAsset.Succeeded()) Instances->SetStaticMesh(ChessTileMeshAsset.Object);
+		ChessTileInstances.Add(Instances);
+	}
+
+	static ConstructorHelpers::FObjectFinder<UMaterialInterface> InstancedTileMaterialAsset(TEXT("/Script/Engine.Material'/Game/+Chess/Materials/ChessTile/M_ChessTile.M_ChessTile'"));
+	if (InstancedTileMaterialAsset.Succeeded()) InstancedTileMaterial = InstancedTileMaterialAsset.Object;
+
+	// ChessPieceInstances, meshes come from ChessBoardData once the board is set up
+	for (int32 i = 0; i < EChessColour::Num * EChessPiece::Num; i++)
+	{
+		UInstancedStaticMeshComponent* Instances = CreateDefaultSubobject<UInstancedStaticMeshComponent>(FName(TEXT("ChessPieceInstances"), i));
+		Instances->SetupAttachment(DefaultSceneRootComponent);
+		Instances->SetCollisionEnabled(ECollisionEnabled::NoCollision); // nothing traces for pieces and freed slots sit at zero scale
+		ChessPieceInstances.Add(Instances);
+	}
+
 	static ConstructorHelpers::FObjectFinder<UChessBoardData> ChessBoardDataAsset(TEXT("/Script/Chess.ChessBoardData'/Game/+Chess/Data/DA_ChessBoardData.DA_ChessBoardData'"));
 	if (ChessBoardDataAsset.Succeeded()) ChessBoardData = ChessBoardDataAsset.Object;
 }
@@ -30,6 +86,12 @@ void AChessBoard::BeginPlay()
 {
 	Super::BeginPlay();
 
+	INC_DWORD_STAT(STAT_ChessBoards);
+
+#if STATS
+	ActiveTicksStatId = FDynamicStats::CreateStatIdInt64<FStatGroup_STATGROUP_Chess>(FString::Printf(TEXT("Active Ticks - %s"), *GetName()), true);
+#endif
+
 	CreateBoard();
 
 	SetupBoard();
@@ -37,9 +99,17 @@ void AChessBoard::BeginPlay()
 	GenerateAllValidMoves(true);
 }
 
-void AChessBoard::Tick(float DeltaTime)
+void AChessBoard::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	Super::Tick(DeltaTime);
+	DEC_DWORD_STAT(STAT_ChessBoards);
+
+	NumActiveTicks = 0;
+
+#if STATS
+	SET_DWORD_STAT_FName(ActiveTicksStatId.GetName(), NumActiveTicks);
+#endif
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void AChessBoard::CreateBoard()
@@ -51,13 +121,24 @@ void AChessBoard::CreateBoard()
 	for (int32 i = 0; i < 8; i++)
 		for (int32 j = 0; j < 8; j++)
 			ChessTileLocations.AddUnique(FVector((i * TileSize) - Offset, (j * TileSize) - Offset, 0.f));
-	
-	// Ensure the board has exactly 64 squares
-	ChessBoardLayout.SetNum(64);
 
-	// Clear all squares to empty pieces
-	for (FChessTileInfo& Square : ChessBoardLayout)
-		Square = FChessTileInfo(); // Initialize as an empty piece
+	if (bUseInstancedTiles)
+	{
+		for (int32 Look = 0; Look < EChessTileLook::Num; Look++)
+		{
+			UInstancedStaticMeshComponent* Instances = ChessTileInstances[Look];
+
+			if (InstancedTileMaterial) Instances->SetMaterial(0, InstancedTileMaterial);
+			Instances->SetCustomPrimitiveDataVector4(EChessTileCustomData::Red, AChessTile::GetCustomData(Look == EChessTileLook::White, Look == EChessTileLook::Highlighted));
+
+			// Added in tile order, so a trace's hit item is the tile index whichever component it hit
+			for (int32 i = 0; i < 64; i++)
+			{
+				const bool bIsShown = (GetChessTileInstancesIndex(TileColourAtIndex[i] == 1, false) == Look);
+				Instances->AddInstance(FTransform(FQuat::Identity, ChessTileLocations[i], bIsShown ? FVector::OneVector : FVector::ZeroVector));
+			}
+		}
+	}
 
 	for (int32 i = 0; i < 64; i++)
 	{
@@ -65,13 +146,13 @@ void AChessBoard::CreateBoard()
 		{
 			Tile->ChessTileInfo.ChessTilePositionIndex = i;
 			Tile->ChessTileInfo.bIsWhite = (TileColourAtIndex[i] == 1);
+			Tile->bRenderedByBoard = bUseInstancedTiles;
 
 			UGameplayStatics::FinishSpawningActor(Tile, FTransform());
 
 			Tile->AttachToActor(this, FAttachmentTransformRules::SnapToTargetIncludingScale);
 			Tile->SetActorRelativeLocation(ChessTileLocations[i]);
 			ChessTiles.AddUnique(Tile);
-			ChessBoardLayout[i] = Tile->ChessTileInfo;
 		}
 	}
 }
@@ -119,6 +200,17 @@ void AChessBoard::SetupBoard()
 	BlackChessPiecesInfo.AddUnique(FChessPieceInfo(false, false, EChessPieceType::King, EChessPieceSide::None, 60));
 #pragma endregion
 
+	if (bUseInstancedPieces)
+	{
+		for (int32 i = 0; i < EChessPiece::Num; i++)
+		{
+			const EChessPieceType ChessPieceType = static_cast<EChessPieceType>(i);
+
+			ChessPieceInstances[GetChessPieceInstancesIndex(true, ChessPieceType)]->SetStaticMesh(ChessBoardData->GetChessPieceMesh(true, ChessPieceType));
+			ChessPieceInstances[GetChessPieceInstancesIndex(false, ChessPieceType)]->SetStaticMesh(ChessBoardData->GetChessPieceMesh(false, ChessPieceType));
+		}
+	}
+
 	// Spawn White Chess Pieces
 	for (int32 i = 0; i < ChessBoardData->WhiteChessPiecesInfo.Num(); i++)
 		WhiteChessPieces.AddUnique(SpawnChessPiece(/*ChessBoardData->*/WhiteChessPiecesInfo[i]));
@@ -126,6 +218,25 @@ void AChessBoard::SetupBoard()
 	// Spawn Black Chess Pieces
 	for (int32 i = 0; i < ChessBoardData->BlackChessPiecesInfo.Num(); i++)
 		BlackChessPieces.AddUnique(SpawnChessPiece(/*ChessBoardData->*/BlackChessPiecesInfo[i]));
+
+	// Build the position the pieces mirror
+	Position.Clear();
+
+	for (AChessPiece* ChessPiece : WhiteChessPieces)
+		if (ChessPiece) Position.AddPiece(EChessColour::White, static_cast<EChessPiece::Type>(ChessPiece->ChessPieceInfo.ChessPieceType), ChessPiece->ChessPieceInfo.ChessPiecePositionIndex);
+
+	for (AChessPiece* ChessPiece : BlackChessPieces)
+		if (ChessPiece) Position.AddPiece(EChessColour::Black, static_cast<EChessPiece::Type>(ChessPiece->ChessPieceInfo.ChessPieceType), ChessPiece->ChessPieceInfo.ChessPiecePositionIndex);
+
+	Position.SetSideToMove(EChessColour::White);
+	Position.SetCastlingRights(EChessCastlingRights::All);
+
+	PositionKeyHistory.Reset();
+	PositionKeyHistory.Add(Position.GetKey());
+
+	// Start from an empty map so the first update mirrors every tile, later turns only touch what the move changed
+	AttackMap = FChessAttackMap();
+	FMemory::Memzero(TilesUnderAttack, sizeof(TilesUnderAttack));
 }
 
 AChessPiece* AChessBoard::SpawnChessPiece(FChessPieceInfo ChessPieceInfo)
@@ -134,61 +245,105 @@ AChessPiece* AChessBoard::SpawnChessPiece(FChessPieceInfo ChessPieceInfo)
 	if (ChessPiece)
 	{
 		ChessPiece->ChessPieceInfo = ChessPieceInfo;
+		ChessPiece->bRenderedByBoard = bUseInstancedPieces;
 
 		UGameplayStatics::FinishSpawningActor(ChessPiece, FTransform());
 
 		ChessPiece->SetActorLocation(ChessTiles[ChessPieceInfo.ChessPiecePositionIndex]->GetActorLocation());
 
+		if (bUseInstancedPieces) AddChessPieceInstance(ChessPiece);
+
 		ChessTiles[ChessPieceInfo.ChessPiecePositionIndex]->ChessTileInfo.ChessPieceOnTile = ChessPiece;
 	}
 
 	return ChessPiece;
 }
 
-void AChessBoard::UpdateAttackStatusOfTiles()
+void AChessBoard::AddChessPieceInstance(AChessPiece* ChessPiece)
 {
-	// Reset values
-	for (AChessTile* Tile : ChessTiles)
+	if (!ChessPiece || ChessPiece->ChessPieceInstanceIndex != INDEX_NONE) return;
+
+	const int32 InstancesIndex = GetChessPieceInstancesIndex(ChessPiece->ChessPieceInfo.bIsWhite, ChessPiece->ChessPieceInfo.ChessPieceType);
+	UInstancedStaticMeshComponent* Instances = ChessPieceInstances[InstancesIndex];
+
+	// Where the piece's own mesh would be, so handing over between the two doesn't pop
+	const FTransform InstanceTransform = ChessPiece->GetChessPieceMesh()->GetComponentTransform();
+
+	TArray<int32>& FreeInstances = FreeChessPieceInstances[InstancesIndex];
+	if (FreeInstances.Num() > 0)
+	{
+		ChessPiece->ChessPieceInstanceIndex = FreeInstances.Pop(EAllowShrinking::No);
+		Instances->UpdateInstanceTransform(ChessPiece->ChessPieceInstanceIndex, InstanceTransform, true, true, true);
+	}
+	else
 	{
-		Tile->ChessTileInfo.bIsTileUnderAttackByWhitePiece = false;
-		Tile->ChessTileInfo.bIsTileUnderAttackByBlackPiece = false;
+		ChessPiece->ChessPieceInstanceIndex = Instances->AddInstance(InstanceTransform, true);
 	}
+}
 
-	ChessTilesUnderAttackByWhitePieces.Empty();
-	ChessTilesUnderAttackByBlackPieces.Empty();
+void AChessBoard::RemoveChessPieceInstance(AChessPiece* ChessPiece)
+{
+	if (!ChessPiece || ChessPiece->ChessPieceInstanceIndex == INDEX_NONE) return;
 
-	for (AChessPiece* WhiteChessPiece : WhiteChessPieces)
+	const int32 InstancesIndex = GetChessPieceInstancesIndex(ChessPiece->ChessPieceInfo.bIsWhite, ChessPiece->ChessPieceInfo.ChessPieceType);
+
+	// Zero scale hides the slot, removing it would shift the instance index of every piece after it
+	ChessPieceInstances[InstancesIndex]->UpdateInstanceTransform(ChessPiece->ChessPieceInstanceIndex, FTransform(FQuat::Identity, FVector::ZeroVector, FVector::ZeroVector), false, true, true);
+
+	FreeChessPieceInstances[InstancesIndex].Add(ChessPiece->ChessPieceInstanceIndex);
+	ChessPiece->ChessPieceInstanceIndex = INDEX_NONE;
+}
+
+void AChessBoard::SetTicking(bool bTicking)
+{
+	if (bTicking) NumActiveTicks++;
+	else if (NumActiveTicks > 0) NumActiveTicks--;
+
+#if STATS
+	SET_DWORD_STAT_FName(ActiveTicksStatId.GetName(), NumActiveTicks);
+#endif
+}
+
+void AChessBoard::UpdateAttackStatusOfTiles()
+{
+	AttackMap.Update(Position);
+
+	uint64 DirtyTiles = 0;
+
+	// Tiles holding a friendly piece aren't shown as under attack by that side
+	for (int32 Colour = 0; Colour < EChessColour::Num; Colour++)
 	{
-		if (!WhiteChessPiece) continue;
+		const uint64 Attacked = AttackMap.GetAttacks(static_cast<EChessColour::Type>(Colour)) & ~Position.GetPieces(static_cast<EChessColour::Type>(Colour));
 
-		WhiteChessPiece->UpdateTilesUnderAttack(ChessTilesUnderAttackByWhitePieces);
+		DirtyTiles |= Attacked ^ TilesUnderAttack[Colour];
+		TilesUnderAttack[Colour] = Attacked;
 	}
 
-	for (FChessTileInfo& TileInfo : ChessTilesUnderAttackByWhitePieces)
-		ChessTiles[TileInfo.ChessTilePositionIndex]->ChessTileInfo.bIsTileUnderAttackByWhitePiece =	true;
-
-	for (AChessPiece* BlackChessPiece : BlackChessPieces)
+	while (DirtyTiles)
 	{
-		if (!BlackChessPiece) continue;
+		const int32 TileIndex = ChessBitboard::PopLeastSignificantSquare(DirtyTiles);
+		if (!ChessTiles.IsValidIndex(TileIndex)) continue;
 
-		BlackChessPiece->UpdateTilesUnderAttack(ChessTilesUnderAttackByBlackPieces);
+		AChessTile* Tile = ChessTiles[TileIndex];
+		Tile->ChessTileInfo.bIsTileUnderAttackByWhitePiece = IsTileUnderAttack(TileIndex, true);
+		Tile->ChessTileInfo.bIsTileUnderAttackByBlackPiece = IsTileUnderAttack(TileIndex, false);
 	}
+}
 
-	for (FChessTileInfo& TileInfo : ChessTilesUnderAttackByBlackPieces)
-		ChessTiles[TileInfo.ChessTilePositionIndex]->ChessTileInfo.bIsTileUnderAttackByBlackPiece = true;
+bool AChessBoard::IsTileUnderAttack(int32 TileIndex, bool bByWhitePieces) const
+{
+	if (TileIndex < 0 || TileIndex > 63) return false;
 
-	// Update ChessBoardLayout
-	for (int32 i = 0; i < ChessTiles.Num(); i++)
-		ChessBoardLayout[i] = ChessTiles[i]->ChessTileInfo;
+	return (TilesUnderAttack[EChessColour::FromIsWhite(bByWhitePieces)] & ChessBitboard::SquareMask(TileIndex)) != 0;
 }
 
 void AChessBoard::ClearAllValidMoves()
 {
 	for (AChessPiece* WhiteChessPiece : WhiteChessPieces)
-		if (WhiteChessPiece) WhiteChessPiece->ValidMoves.Empty();
+		if (WhiteChessPiece) WhiteChessPiece->ValidMoves = 0;
 
 	for (AChessPiece* BlackChessPiece : BlackChessPieces)
-		if (BlackChessPiece) BlackChessPiece->ValidMoves.Empty();
+		if (BlackChessPiece) BlackChessPiece->ValidMoves = 0;
 }
 
 void AChessBoard::GenerateAllValidMoves(bool bIsWhiteTurn)
@@ -197,21 +352,30 @@ void AChessBoard::GenerateAllValidMoves(bool bIsWhiteTurn)
 
 	UpdateAttackStatusOfTiles();
 
-	if (bIsWhiteTurn)
-	{
-		// Calculate White Pieces Moves
-		for (AChessPiece* WhiteChessPiece : WhiteChessPieces)
-			if (WhiteChessPiece) WhiteChessPiece->CalculateValidMoves();
-	}
-	else
+	if (Position.GetSideToMove() != EChessColour::FromIsWhite(bIsWhiteTurn))
+		PRINTSTRING(FColor::Red, "Position side to move is out of sync with turn : ChessBoard.cpp > GenerateAllValidMoves()");
+
+	bIsWhiteKingUnderCheck = Position.IsInCheck(EChessColour::White);
+	bIsBlackKingUnderCheck = Position.IsInCheck(EChessColour::Black);
+
+	FChessMoveGenerator::GenerateLegalMoves(Position, LegalMoves);
+
+	// Mirror legal moves onto the piece actors
+	for (const FChessMove& Move : LegalMoves)
 	{
-		// Calculate Black Pieces Moves
-		for (AChessPiece* BlackChessPiece : BlackChessPieces)
-			if (BlackChessPiece) BlackChessPiece->CalculateValidMoves();
+		AChessPiece* ChessPiece = ChessTiles[Move.GetFrom()]->ChessTileInfo.ChessPieceOnTile;
+		if (!ChessPiece)
+		{
+			PRINTSTRING(FColor::Red, "Piece actors out of sync with Position : ChessBoard.cpp > GenerateAllValidMoves()");
+			continue;
+		}
+
+		// the four promotions share a tile, the bit just gets set again
+		ChessPiece->ValidMoves |= ChessBitboard::SquareMask(Move.GetTo());
 	}
 }
 
-bool AChessBoard::HightlightValidMovesOnTile(bool bHighlight, FChessTileInfo ChessTileInfo)
+bool AChessBoard::HightlightValidMovesOnTile(bool bHighlight, const FChessTileInfo& ChessTileInfo)
 {
 	if (!ChessTileInfo.ChessPieceOnTile)
 	{
@@ -223,21 +387,103 @@ bool AChessBoard::HightlightValidMovesOnTile(bool bHighlight, FChessTileInfo Che
 	{
 		HighlightedTiles = ChessTileInfo.ChessPieceOnTile->ValidMoves;
 
-		if (HighlightedTiles.Num() == 0) return false;
-
-		for (FChessTileInfo& Tile : HighlightedTiles) ChessTiles[Tile.ChessTilePositionIndex]->HighlightTile(true);
+		if (!HighlightedTiles) return false;
 
+		for (uint64 Tiles = HighlightedTiles; Tiles;) HighlightTile(ChessBitboard::PopLeastSignificantSquare(Tiles), true);
 	}
 	else
 	{
-		for (FChessTileInfo& Tile : HighlightedTiles) ChessTiles[Tile.ChessTilePositionIndex]->HighlightTile(false);
+		for (uint64 Tiles = HighlightedTiles; Tiles;) HighlightTile(ChessBitboard::PopLeastSignificantSquare(Tiles), false);
 
-		HighlightedTiles.Empty();
+		HighlightedTiles = 0;
 	}
 
+	// One render state update for the whole set of instances
+	if (bUseInstancedTiles)
+		for (UInstancedStaticMeshComponent* Instances : ChessTileInstances) Instances->MarkRenderStateDirty();
+
 	return true;
 }
 
+AChessTile* AChessBoard::GetChessTileFromHit(const FHitResult& HitResult) const
+{
+	if (AChessTile* Tile = Cast<AChessTile>(HitResult.GetActor())) return Tile;
+
+	if (bUseInstancedTiles && ChessTileInstances.Contains(HitResult.GetComponent()) && ChessTiles.IsValidIndex(HitResult.Item)) return ChessTiles[HitResult.Item];
+
+	return nullptr;
+}
+
+void AChessBoard::HighlightTile(int32 TileIndex, bool bHighlight)
+{
+	if (!ChessTiles.IsValidIndex(TileIndex)) return PRINTSTRING(FColor::Red, "Tile index is off the board : ChessBoard.cpp > HighlightTile()");
+
+	AChessTile* Tile = ChessTiles[TileIndex];
+
+	if (!bUseInstancedTiles) return Tile->HighlightTile(bHighlight);
+
+	const int32 FromIndex = GetChessTileInstancesIndex(Tile->ChessTileInfo.bIsWhite, Tile->ChessTileInfo.bIsHighlighted);
+	const int32 ToIndex = GetChessTileInstancesIndex(Tile->ChessTileInfo.bIsWhite, bHighlight);
+
+	// Swaps which component shows the tile, callers mark the render state dirty once they have changed every tile they meant to
+	if (FromIndex != ToIndex)
+	{
+		ChessTileInstances[FromIndex]->UpdateInstanceTransform(TileIndex, FTransform(FQuat::Identity, ChessTileLocations[TileIndex], FVector::ZeroVector), false, false, true);
+		ChessTileInstances[ToIndex]->UpdateInstanceTransform(TileIndex, FTransform(ChessTileLocations[TileIndex]), false, false, true);
+	}
+
+	Tile->ChessTileInfo.bIsHighlighted = bHighlight;
+}
+
+FChessMove AChessBoard::ApplyMoveToPosition(int32 FromIndex, int32 ToIndex)
+{
+	// Promotions are generated queen first, so a plain tile to tile move defaults to a queen until PromotePawn says otherwise
+	for (const FChessMove& Move : LegalMoves)
+	{
+		if (Move.GetFrom() == FromIndex && Move.GetTo() == ToIndex)
+		{
+			Position.ApplyMove(Move);
+			PositionKeyHistory.Add(Position.GetKey());
+			OnPositionChanged.Broadcast();
+			return Move;
+		}
+	}
+
+	PRINTSTRING(FColor::Red, "Move is not legal in Position : ChessBoard.cpp > ApplyMoveToPosition()");
+	return FChessMove();
+}
+
+void AChessBoard::PromotePieceOnPosition(int32 PositionIndex, EChessPieceType PromotionType)
+{
+	EChessColour::Type Colour;
+	EChessPiece::Type Piece;
+	if (!Position.GetPieceOnSquare(PositionIndex, Colour, Piece)) return PRINTSTRING(FColor::Red, "No piece to promote in Position : ChessBoard.cpp > PromotePieceOnPosition()");
+
+	Position.RemovePiece(Colour, Piece, PositionIndex);
+	Position.AddPiece(Colour, static_cast<EChessPiece::Type>(PromotionType), PositionIndex);
+
+	if (PositionKeyHistory.Num() > 0) PositionKeyHistory.Last() = Position.GetKey();
+
+	// the promoted piece changes what the side to move can do
+	GenerateAllValidMoves(Position.GetSideToMove() == EChessColour::White);
+
+	OnPositionChanged.Broadcast();
+}
+
+bool AChessBoard::IsThreefoldRepetition() const
+{
+	const uint64 CurrentKey = Position.GetKey();
+
+	// a capture or pawn move can't be undone, so only the last HalfmoveClock positions can repeat
+	const int32 Oldest = FMath::Max(0, PositionKeyHistory.Num() - 1 - Position.GetHalfmoveClock());
+
+	int32 Occurrences = 0;
+	for (int32 i = PositionKeyHistory.Num() - 1; i >= Oldest; i -= 2)
+		if (PositionKeyHistory[i] == CurrentKey) Occurrences++;
+
+	return Occurrences >= 3;
+}
+
 void AChessBoard::EnableEnpassant(AChessPiece* EnpassantPiece)
 {
 	if (!EnpassantPiece) return PRINTSTRING(FColor::Red, "EnpassantPiece Invalid in ChessBoard");
@@ -265,70 +511,4 @@ void AChessBoard::DisableEnpassant(bool bIsWhite)
 
 		ChessPlayerController->OnPieceMoved.RemoveDynamic(this, &AChessBoard::DisableEnpassant);
 	}
-}
-
-bool AChessBoard::IsKingInCheck(bool bIsWhiteKing, const TArray<FChessTileInfo>& BoardLayout, int32 OutEnpassantTarget) const
-{
-	// Locate the king
-	int32 KingPosition = -1;
-	for (int32 i = 0; i < BoardLayout.Num(); i++)
-	{
-		if (BoardLayout[i].ChessPieceOnTile)
-		{
-			if (BoardLayout[i].ChessPieceOnTile->ChessPieceInfo.ChessPieceType == EChessPieceType::King && BoardLayout[i].ChessPieceOnTile->ChessPieceInfo.bIsWhite == bIsWhiteKing)
-			{
-				KingPosition = i;
-				break;
-			}
-		}
-	}
-
-	if (KingPosition == -1) {
-		// King not found on the board (shouldn't happen in a valid game state)
-		return false;
-	}
-
-	 //Check for threats from opponent pieces
-	for (int32 i = 0; i < BoardLayout.Num(); i++)
-	{
-		const FChessTileInfo& OpponentPieceTile = BoardLayout[i];
-
-		if (!OpponentPieceTile.ChessPieceOnTile) continue;
-
-		if (OpponentPieceTile.ChessPieceOnTile->ChessPieceInfo.bIsWhite != bIsWhiteKing)
-		{
-			// Get valid moves for the opponent piece
-			TArray<FChessTileInfo> OpponentMoves;
-
-			switch (OpponentPieceTile.ChessPieceOnTile->ChessPieceInfo.ChessPieceType)
-			{
-			case EChessPieceType::King:
-				OpponentMoves = OpponentPieceTile.ChessPieceOnTile->CalculateValidMoveTilesForKing(BoardLayout);
-				break;
-			case EChessPieceType::Queen:
-				OpponentMoves = OpponentPieceTile.ChessPieceOnTile->CalculateValidMoveTilesForQueen(BoardLayout);
-				break;
-			case EChessPieceType::Bishop:
-				OpponentMoves = OpponentPieceTile.ChessPieceOnTile->CalculateValidMoveTilesForBishop(BoardLayout);
-				break;
-			case EChessPieceType::Knight:
-				OpponentMoves = OpponentPieceTile.ChessPieceOnTile->CalculateValidMoveTilesForKnight(BoardLayout);
-				break;
-			case EChessPieceType::Rook:
-				OpponentMoves = OpponentPieceTile.ChessPieceOnTile->CalculateValidMoveTilesForRook(BoardLayout);
-				break;
-			case EChessPieceType::Pawn:
-				OpponentMoves = OpponentPieceTile.ChessPieceOnTile->CalculateValidMoveTilesForPawn(BoardLayout, OutEnpassantTarget);
-				break;
-			default:
-				break;
-			}
-
-			// Check if the king's position is in the opponent's moves
-			if (OpponentMoves.Contains(BoardLayout[KingPosition]))
-				return true; // The king is in check
-		}
-	}
-
-	return false; // The king is not in check
 }
\ No newline at end of file
@@ -0,0 +1,300 @@
+// Copyright Kunal Patil (kroxyserver). All Rights Reserved.
+
+#include "Board/ChessMoveGenerator.h"
+
+#include "Board/ChessPosition.h"
+
+namespace
+{
+	void AddPawnMoves(int32 From, int32 To, bool bIsCapture, FChessMoveList& OutMoves)
+	{
+		// Pawn reaching the last rank must promote
+		if (ChessBitboard::SquareMask(To) & (ChessBitboard::Rank1 | ChessBitboard::Rank8))
+		{
+			const uint8 CaptureFlag = bIsCapture ? EChessMoveFlag::Capture : 0;
+			OutMoves.Add(FChessMove(From, To, static_cast<EChessMoveFlag::Type>(EChessMoveFlag::QueenPromotion | CaptureFlag)));
+			OutMoves.Add(FChessMove(From, To, static_cast<EChessMoveFlag::Type>(EChessMoveFlag::RookPromotion | CaptureFlag)));
+			OutMoves.Add(FChessMove(From, To, static_cast<EChessMoveFlag::Type>(EChessMoveFlag::BishopPromotion | CaptureFlag)));
+			OutMoves.Add(FChessMove(From, To, static_cast<EChessMoveFlag::Type>(EChessMoveFlag::KnightPromotion | CaptureFlag)));
+		}
+		else
+		{
+			OutMoves.Add(FChessMove(From, To, bIsCapture ? EChessMoveFlag::Capture : EChessMoveFlag::Quiet));
+		}
+	}
+
+	void AddMovesToTargets(int32 From, uint64 Targets, uint64 Enemies, FChessMoveList& OutMoves)
+	{
+		while (Targets)
+		{
+			const int32 To = ChessBitboard::PopLeastSignificantSquare(Targets);
+			OutMoves.Add(FChessMove(From, To, (Enemies & ChessBitboard::SquareMask(To)) ? EChessMoveFlag::Capture : EChessMoveFlag::Quiet));
+		}
+	}
+
+	// En passant removes two pieces from one rank, so it can expose the king in ways the pin mask doesn't see
+	bool IsEnPassantLegal(const FChessPosition& Position, int32 From, int32 To)
+	{
+		const EChessColour::Type Us = Position.GetSideToMove();
+		const EChessColour::Type Them = EChessColour::GetOpposite(Us);
+
+		const int32 KingSquare = Position.GetKingSquare(Us);
+		const int32 CapturedSquare = (Us == EChessColour::White) ? To - 8 : To + 8;
+
+		const uint64 Occupied = (Position.GetOccupied() ^ ChessBitboard::SquareMask(From) ^ ChessBitboard::SquareMask(CapturedSquare)) | ChessBitboard::SquareMask(To);
+		const uint64 Queens = Position.GetPieces(Them, EChessPiece::Queen);
+
+		return !(ChessBitboard::GetRookAttacks(KingSquare, Occupied) & (Position.GetPieces(Them, EChessPiece::Rook) | Queens))
+			&& !(ChessBitboard::GetBishopAttacks(KingSquare, Occupied) & (Position.GetPieces(Them, EChessPiece::Bishop) | Queens))
+			&& !(ChessBitboard::GetKnightAttacks(KingSquare) & Position.GetPieces(Them, EChessPiece::Knight))
+			&& !(ChessBitboard::GetPawnAttacks(Us == EChessColour::White, KingSquare) & Position.GetPieces(Them, EChessPiece::Pawn) & ~ChessBitboard::SquareMask(CapturedSquare));
+	}
+}
+
+void FChessMoveGenerator::GenerateLegalMoves(const FChessPosition& Position, FChessMoveList& OutMoves)
+{
+	GenerateMoves(Position, EChessMoveGeneration::All, OutMoves);
+}
+
+void FChessMoveGenerator::GenerateLegalCaptures(const FChessPosition& Position, FChessMoveList& OutMoves)
+{
+	GenerateMoves(Position, EChessMoveGeneration::Captures, OutMoves);
+}
+
+void FChessMoveGenerator::GenerateLegalQuiets(const FChessPosition& Position, FChessMoveList& OutMoves)
+{
+	GenerateMoves(Position, EChessMoveGeneration::Quiets, OutMoves);
+}
+
+void FChessMoveGenerator::GenerateMoves(const FChessPosition& Position, EChessMoveGeneration::Type Generation, FChessMoveList& OutMoves)
+{
+	OutMoves.Reset();
+
+	const EChessColour::Type Us = Position.GetSideToMove();
+	const EChessColour::Type Them = EChessColour::GetOpposite(Us);
+	const bool bIsWhite = (Us == EChessColour::White);
+
+	const uint64 Friendly = Position.GetPieces(Us);
+	const uint64 Enemies = Position.GetPieces(Them);
+	const uint64 Occupied = Position.GetOccupied();
+
+	const int32 KingSquare = Position.GetKingSquare(Us);
+	const uint64 EnemyQueens = Position.GetPieces(Them, EChessPiece::Queen);
+	const uint64 EnemyStraightSliders = Position.GetPieces(Them, EChessPiece::Rook) | EnemyQueens;
+	const uint64 EnemyDiagonalSliders = Position.GetPieces(Them, EChessPiece::Bishop) | EnemyQueens;
+
+	const uint64 Checkers = Position.GetAttackersTo(KingSquare, Occupied) & Enemies;
+
+	// Squares a non pawn move may land on, pawns handle their own pushes and promotions
+	const uint64 Targets = (Generation == EChessMoveGeneration::Captures) ? Enemies : (Generation == EChessMoveGeneration::Quiets) ? ~Occupied : ~Friendly;
+
+	const bool bGenerateCaptures = (Generation != EChessMoveGeneration::Quiets);
+	const bool bGenerateQuiets = (Generation != EChessMoveGeneration::Captures);
+
+	// King moves, sliders see through the king so it can't step back along the checking ray
+	{
+		const uint64 OccupiedWithoutKing = Occupied ^ ChessBitboard::SquareMask(KingSquare);
+
+		for (uint64 KingTargets = ChessBitboard::GetKingAttacks(KingSquare) & Targets; KingTargets;)
+		{
+			const int32 To = ChessBitboard::PopLeastSignificantSquare(KingTargets);
+
+			if (Position.GetAttackersTo(To, OccupiedWithoutKing) & Enemies) continue;
+
+			OutMoves.Add(FChessMove(KingSquare, To, (Enemies & ChessBitboard::SquareMask(To)) ? EChessMoveFlag::Capture : EChessMoveFlag::Quiet));
+		}
+	}
+
+	// In double check only the king can move
+	if (ChessBitboard::HasMoreThanOne(Checkers)) return;
+
+	// Evasion mask : capture the checker or block the ray, everything goes when not in check
+	const uint64 CheckMask = Checkers ? (Checkers | ChessBitboard::GetBetween(KingSquare, ChessBitboard::GetLeastSignificantSquare(Checkers))) : ChessBitboard::Full;
+
+	// Pinned pieces : the only friendly piece between the king and an enemy slider lined up with it
+	uint64 Pinned = 0;
+	{
+		uint64 Snipers = (ChessBitboard::GetRookAttacks(KingSquare, ChessBitboard::Empty) & EnemyStraightSliders)
+			| (ChessBitboard::GetBishopAttacks(KingSquare, ChessBitboard::Empty) & EnemyDiagonalSliders);
+
+		while (Snipers)
+		{
+			const uint64 Blockers = ChessBitboard::GetBetween(KingSquare, ChessBitboard::PopLeastSignificantSquare(Snipers)) & Occupied;
+
+			if (Blockers && !ChessBitboard::HasMoreThanOne(Blockers)) Pinned |= Blockers & Friendly;
+		}
+	}
+
+	// Pinned pieces may only move along the line through the king
+	auto GetAllowedTargets = [&](int32 From) -> uint64
+	{
+		const uint64 Allowed = CheckMask & ~Friendly;
+		return (Pinned & ChessBitboard::SquareMask(From)) ? (Allowed & ChessBitboard::GetLine(KingSquare, From)) : Allowed;
+	};
+
+	// Pawns
+	{
+		const int32 Forward = bIsWhite ? 8 : -8;
+		const uint64 StartRank = bIsWhite ? ChessBitboard::Rank2 : ChessBitboard::Rank7;
+		const uint64 PromotionRanks = ChessBitboard::Rank1 | ChessBitboard::Rank8;
+
+		for (uint64 Pawns = Position.GetPieces(Us, EChessPiece::Pawn); Pawns;)
+		{
+			const int32 From = ChessBitboard::PopLeastSignificantSquare(Pawns);
+			const uint64 Allowed = GetAllowedTargets(From);
+
+			// Push promotions go with the captures, they change the material balance just as much
+			const int32 SinglePush = From + Forward;
+			const bool bIsPromotion = (ChessBitboard::SquareMask(SinglePush) & PromotionRanks) != 0;
+			if (!(Occupied & ChessBitboard::SquareMask(SinglePush)) && (bIsPromotion ? bGenerateCaptures : bGenerateQuiets))
+			{
+				if (Allowed & ChessBitboard::SquareMask(SinglePush)) AddPawnMoves(From, SinglePush, false, OutMoves);
+
+				const int32 DoublePush = SinglePush + Forward;
+				if (!bIsPromotion && (StartRank & ChessBitboard::SquareMask(From)) && !(Occupied & ChessBitboard::SquareMask(DoublePush)) && (Allowed & ChessBitboard::SquareMask(DoublePush)))
+					OutMoves.Add(FChessMove(From, DoublePush, EChessMoveFlag::DoublePawnPush));
+			}
+
+			if (!bGenerateCaptures) continue;
+
+			const uint64 Attacks = ChessBitboard::GetPawnAttacks(bIsWhite, From);
+
+			for (uint64 Captures = Attacks & Enemies & Allowed; Captures;)
+				AddPawnMoves(From, ChessBitboard::PopLeastSignificantSquare(Captures), true, OutMoves);
+
+			const int32 EnPassantSquare = Position.GetEnPassantSquare();
+			if (EnPassantSquare >= 0 && (Attacks & ChessBitboard::SquareMask(EnPassantSquare)) && IsEnPassantLegal(Position, From, EnPassantSquare))
+				OutMoves.Add(FChessMove(From, EnPassantSquare, EChessMoveFlag::EnPassant));
+		}
+	}
+
+	// Knights, a pinned knight can never stay on the pin line
+	for (uint64 Knights = Position.GetPieces(Us, EChessPiece::Knight) & ~Pinned; Knights;)
+	{
+		const int32 From = ChessBitboard::PopLeastSignificantSquare(Knights);
+		AddMovesToTargets(From, ChessBitboard::GetKnightAttacks(From) & GetAllowedTargets(From) & Targets, Enemies, OutMoves);
+	}
+
+	// Bishops and diagonal Queen moves
+	for (uint64 Bishops = Position.GetPieces(Us, EChessPiece::Bishop) | Position.GetPieces(Us, EChessPiece::Queen); Bishops;)
+	{
+		const int32 From = ChessBitboard::PopLeastSignificantSquare(Bishops);
+		AddMovesToTargets(From, ChessBitboard::GetBishopAttacks(From, Occupied) & GetAllowedTargets(From) & Targets, Enemies, OutMoves);
+	}
+
+	// Rooks and straight Queen moves
+	for (uint64 Rooks = Position.GetPieces(Us, EChessPiece::Rook) | Position.GetPieces(Us, EChessPiece::Queen); Rooks;)
+	{
+		const int32 From = ChessBitboard::PopLeastSignificantSquare(Rooks);
+		AddMovesToTargets(From, ChessBitboard::GetRookAttacks(From, Occupied) & GetAllowedTargets(From) & Targets, Enemies, OutMoves);
+	}
+
+	// Castling : not in check, squares between king and rook empty, king doesn't pass through or land on an attacked tile
+	if (Checkers || !bGenerateQuiets) return;
+
+	const EChessCastlingRights::Type KingSideRight = bIsWhite ? EChessCastlingRights::WhiteKingSide : EChessCastlingRights::BlackKingSide;
+	const EChessCastlingRights::Type QueenSideRight = bIsWhite ? EChessCastlingRights::WhiteQueenSide : EChessCastlingRights::BlackQueenSide;
+
+	if (Position.HasCastlingRight(KingSideRight)
+		&& !(Occupied & ChessBitboard::GetBetween(KingSquare, KingSquare + 3))
+		&& !Position.IsSquareAttacked(KingSquare + 1, Them)
+		&& !Position.IsSquareAttacked(KingSquare + 2, Them))
+		OutMoves.Add(FChessMove(KingSquare, KingSquare + 2, EChessMoveFlag::KingCastle));
+
+	if (Position.HasCastlingRight(QueenSideRight)
+		&& !(Occupied & ChessBitboard::GetBetween(KingSquare, KingSquare - 4))
+		&& !Position.IsSquareAttacked(KingSquare - 1, Them)
+		&& !Position.IsSquareAttacked(KingSquare - 2, Them))
+		OutMoves.Add(FChessMove(KingSquare, KingSquare - 2, EChessMoveFlag::QueenCastle));
+}
+
+bool FChessMoveGenerator::IsPseudoLegal(const FChessPosition& Position, FChessMove Move)
+{
+	if (!Move.IsValid()) return false;
+
+	const EChessColour::Type Us = Position.GetSideToMove();
+	const EChessColour::Type Them = EChessColour::GetOpposite(Us);
+	const bool bIsWhite = (Us == EChessColour::White);
+
+	const int32 From = Move.GetFrom();
+	const int32 To = Move.GetTo();
+	const uint64 ToMask = ChessBitboard::SquareMask(To);
+	const uint64 Occupied = Position.GetOccupied();
+	const EChessMoveFlag::Type Flag = Move.GetFlag();
+
+	EChessColour::Type Colour;
+	EChessPiece::Type Piece;
+	if (!Position.GetPieceOnSquare(From, Colour, Piece) || Colour != Us) return false;
+
+	if (Position.GetPieces(Us) & ToMask) return false;
+
+	// Flags 6 and 7 are never generated
+	if (Flag > EChessMoveFlag::EnPassant && !Move.IsPromotion()) return false;
+
+	if (Move.IsEnPassant())
+		return Piece == EChessPiece::Pawn && To == Position.GetEnPassantSquare() && (ChessBitboard::GetPawnAttacks(bIsWhite, From) & ToMask);
+
+	// The capture flag has to agree with what is on the target square
+	if (Move.IsCapture() != ((Position.GetPieces(Them) & ToMask) != 0)) return false;
+
+	if (Move.IsCastle())
+	{
+		const bool bIsKingSide = (Flag == EChessMoveFlag::KingCastle);
+		const EChessCastlingRights::Type Right = bIsWhite
+			? (bIsKingSide ? EChessCastlingRights::WhiteKingSide : EChessCastlingRights::WhiteQueenSide)
+			: (bIsKingSide ? EChessCastlingRights::BlackKingSide : EChessCastlingRights::BlackQueenSide);
+
+		// Holding the right means king and rook are still on their starting squares
+		if (Piece != EChessPiece::King || !Position.HasCastlingRight(Right) || To != From + (bIsKingSide ? 2 : -2)) return false;
+
+		const int32 Step = bIsKingSide ? 1 : -1;
+
+		return !(Occupied & ChessBitboard::GetBetween(From, bIsKingSide ? From + 3 : From - 4))
+			&& !Position.IsInCheck()
+			&& !Position.IsSquareAttacked(From + Step, Them)
+			&& !Position.IsSquareAttacked(From + 2 * Step, Them);
+	}
+
+	if (Piece == EChessPiece::Pawn)
+	{
+		if (Move.IsPromotion() != ((ToMask & (ChessBitboard::Rank1 | ChessBitboard::Rank8)) != 0)) return false;
+
+		if (Move.IsCapture()) return (ChessBitboard::GetPawnAttacks(bIsWhite, From) & ToMask) != 0;
+
+		const int32 Forward = bIsWhite ? 8 : -8;
+
+		if (Flag == EChessMoveFlag::DoublePawnPush)
+		{
+			const uint64 StartRank = bIsWhite ? ChessBitboard::Rank2 : ChessBitboard::Rank7;
+			return (StartRank & ChessBitboard::SquareMask(From)) && To == From + 2 * Forward && !(Occupied & (ChessBitboard::SquareMask(From + Forward) | ToMask));
+		}
+
+		return To == From + Forward && !(Occupied & ToMask);
+	}
+
+	if (Move.IsPromotion() || Flag == EChessMoveFlag::DoublePawnPush) return false;
+
+	switch (Piece)
+	{
+	case EChessPiece::King:		return (ChessBitboard::GetKingAttacks(From) & ToMask) != 0;
+	case EChessPiece::Queen:	return (ChessBitboard::GetQueenAttacks(From, Occupied) & ToMask) != 0;
+	case EChessPiece::Bishop:	return (ChessBitboard::GetBishopAttacks(From, Occupied) & ToMask) != 0;
+	case EChessPiece::Knight:	return (ChessBitboard::GetKnightAttacks(From) & ToMask) != 0;
+	case EChessPiece::Rook:		return (ChessBitboard::GetRookAttacks(From, Occupied) & ToMask) != 0;
+	default:					return false;
+	}
+}
+
+bool FChessMoveGenerator::IsLegal(FChessPosition& Position, FChessMove Move)
+{
+	const EChessColour::Type Us = Position.GetSideToMove();
+
+	FChessUndoInfo Undo;
+	Position.MakeMove(Move, Undo);
+
+	const bool bIsLegal = !Position.IsInCheck(Us);
+
+	Position.UnmakeMove(Move, Undo);
+
+	return bIsLegal;
+}
@@ -0,0 +1,79 @@
+// Copyright Kunal Patil (kroxyserver). All Rights Reserved.
+
+#include "Board/ChessPerft.h"
+
+#include "Board/ChessMoveGenerator.h"
+#include "Board/ChessPosition.h"
+
+uint64 FChessPerft::Perft(FChessPosition& Position, int32 Depth)
+{
+	if (Depth <= 0) return 1;
+
+	FChessMoveList Moves;
+	FChessMoveGenerator::GenerateLegalMoves(Position, Moves);
+
+	// Bulk count the last ply, every generated move is legal
+	if (Depth == 1) return Moves.Num;
+
+	uint64 Nodes = 0;
+
+	for (const FChessMove& Move : Moves)
+	{
+		FChessUndoInfo Undo;
+		Position.MakeMove(Move, Undo);
+		Nodes += Perft(Position, Depth - 1);
+		Position.UnmakeMove(Move, Undo);
+	}
+
+	return Nodes;
+}
+
+uint64 FChessPerft::Divide(FChessPosition& Position, int32 Depth, TArray<FChessPerftDivideEntry>& OutEntries)
+{
+	OutEntries.Reset();
+
+	if (Depth <= 0) return 1;
+
+	FChessMoveList Moves;
+	FChessMoveGenerator::GenerateLegalMoves(Position, Moves);
+
+	uint64 Nodes = 0;
+
+	for (const FChessMove& Move : Moves)
+	{
+		FChessUndoInfo Undo;
+		Position.MakeMove(Move, Undo);
+
+		FChessPerftDivideEntry& Entry = OutEntries.AddDefaulted_GetRef();
+		Entry.Move = Move;
+		Entry.Nodes = Perft(Position, Depth - 1);
+		Nodes += Entry.Nodes;
+
+		Position.UnmakeMove(Move, Undo);
+	}
+
+	return Nodes;
+}
+
+const TArray<FChessPerftCase>& FChessPerft::GetStandardSuite()
+{
+	static const TArray<FChessPerftCase> Suite =
+	{
+		{ TEXT("Start Position"), TEXT("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"), { 20, 400, 8902, 197281, 4865609, 119060324 } },
+		{ TEXT("Kiwipete"), TEXT("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1"), { 48, 2039, 97862, 4085603, 193690690 } },
+		{ TEXT("Rook Endgame"), TEXT("8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1"), { 14, 191, 2812, 43238, 674624, 11030083, 178633661 } },
+		{ TEXT("Promotions"), TEXT("r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1"), { 6, 264, 9467, 422333, 15833292 } },
+		{ TEXT("Promotions Mirrored"), TEXT("r2q1rk1/pP1p2pp/Q4n2/bbp1p3/Np6/1B3NBn/pPPP1PPP/R3K2R b KQ - 0 1"), { 6, 264, 9467, 422333, 15833292 } },
+		{ TEXT("Discovered Checks"), TEXT("rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8"), { 44, 1486, 62379, 2103487, 89941194 } },
+		{ TEXT("Middlegame"), TEXT("r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10"), { 46, 2079, 89890, 3894594, 164075551 } },
+		{ TEXT("Illegal En Passant"), TEXT("3k4/3p4/8/K1P4r/8/8/8/8 b - - 0 1"), { 18, 92, 1670, 10138, 185429, 1134888 } },
+		{ TEXT("En Passant Gives Check"), TEXT("8/8/1k6/2b5/2pP4/8/5K2/8 b - d3 0 1"), { 15, 126, 1928, 13931, 206379, 1440467 } },
+		{ TEXT("Castling Gives Check"), TEXT("5k2/8/8/8/8/8/8/4K2R w K - 0 1"), { 15, 66, 1198, 6399, 120330, 661072 } },
+		{ TEXT("Castling Prevented"), TEXT("r3k2r/8/3Q4/8/8/5q2/8/R3K2R b KQkq - 0 1"), { 44, 1494, 50509, 1720476 } },
+		{ TEXT("Promote Out Of Check"), TEXT("2K2r2/4P3/8/8/8/8/8/3k4 w - - 0 1"), { 11, 133, 1442, 19174, 266199, 3821001 } },
+		{ TEXT("Under Promotion Check"), TEXT("8/P1k5/K7/8/8/8/8/8 w - - 0 1"), { 6, 27, 273, 1329, 18135, 92683 } },
+		{ TEXT("Stalemate And Checkmate"), TEXT("8/k1P5/8/1K6/8/8/8/8 w - - 0 1"), { 10, 25, 268, 926, 10857, 43261, 567584 } }
+	};
+
+	return Suite;
+}
@@ -0,0 +1,402 @@
+// Copyright Kunal Patil (kroxyserver). All Rights Reserved.
+
+#include "Board/ChessPosition.h"
+
+namespace
+{
+	// Castling rights that survive a move touching the square (king or rook leaving / rook being captured)
+	constexpr uint8 CastlingRightsMask[64] =
+	{
+		13, 15, 15, 15, 12, 15, 15, 14,
+		15, 15, 15, 15, 15, 15, 15, 15,
+		15, 15, 15, 15, 15, 15, 15, 15,
+		15, 15, 15, 15, 15, 15, 15, 15,
+		15, 15, 15, 15, 15, 15, 15, 15,
+		15, 15, 15, 15, 15, 15, 15, 15,
+		15, 15, 15, 15, 15, 15, 15, 15,
+		 7, 15, 15, 15,  3, 15, 15, 11
+	};
+
+	constexpr TCHAR PieceFenCharacters[EChessPiece::Num] = { TCHAR('k'), TCHAR('q'), TCHAR('b'), TCHAR('n'), TCHAR('r'), TCHAR('p') };
+}
+
+FChessPosition::FChessPosition()
+{
+	Clear();
+}
+
+void FChessPosition::Clear()
+{
+	FMemory::Memzero(PieceBitboards, sizeof(PieceBitboards));
+	FMemory::Memzero(ColourBitboards, sizeof(ColourBitboards));
+
+	OccupiedBitboard = 0;
+	FMemory::Memset(Mailbox, ChessMailbox::Empty, sizeof(Mailbox));
+	SideToMove = EChessColour::White;
+	CastlingRights = EChessCastlingRights::None;
+	EnPassantSquare = -1;
+	HalfmoveClock = 0;
+	FullmoveNumber = 1;
+	Key = 0;
+	MiddlegameScore = 0;
+	EndgameScore = 0;
+	Phase = 0;
+}
+
+void FChessPosition::SetStartingPosition()
+{
+	SetFromFen(TEXT("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"));
+}
+
+bool FChessPosition::SetFromFen(const FString& Fen)
+{
+	Clear();
+
+	const TCHAR* Character = *Fen;
+
+	// Piece placement, starting from the eighth rank
+	int32 Rank = 7;
+	int32 File = 0;
+
+	for (; *Character && *Character != TCHAR(' '); Character++)
+	{
+		if (*Character == TCHAR('/'))
+		{
+			Rank--;
+			File = 0;
+			continue;
+		}
+
+		if (*Character >= TCHAR('1') && *Character <= TCHAR('8'))
+		{
+			File += *Character - TCHAR('0');
+			continue;
+		}
+
+		const bool bIsWhite = (*Character >= TCHAR('A') && *Character <= TCHAR('Z'));
+		const TCHAR LowerCharacter = bIsWhite ? TCHAR(*Character - TCHAR('A') + TCHAR('a')) : *Character;
+
+		int32 PieceIndex = 0;
+		while (PieceIndex < EChessPiece::Num && PieceFenCharacters[PieceIndex] != LowerCharacter) PieceIndex++;
+
+		if (PieceIndex == EChessPiece::Num || Rank < 0 || File > 7) return false;
+
+		AddPiece(EChessColour::FromIsWhite(bIsWhite), static_cast<EChessPiece::Type>(PieceIndex), ChessBitboard::MakeSquare(Rank, File));
+		File++;
+	}
+
+	if (ChessBitboard::CountBits(PieceBitboards[EChessColour::White][EChessPiece::King]) != 1) return false;
+	if (ChessBitboard::CountBits(PieceBitboards[EChessColour::Black][EChessPiece::King]) != 1) return false;
+
+	// Side to move
+	while (*Character == TCHAR(' ')) Character++;
+	if (*Character) SideToMove = (*Character++ == TCHAR('b')) ? EChessColour::Black : EChessColour::White;
+
+	// Castling rights
+	while (*Character == TCHAR(' ')) Character++;
+	for (; *Character && *Character != TCHAR(' '); Character++)
+	{
+		switch (*Character)
+		{
+		case TCHAR('K'): CastlingRights |= EChessCastlingRights::WhiteKingSide; break;
+		case TCHAR('Q'): CastlingRights |= EChessCastlingRights::WhiteQueenSide; break;
+		case TCHAR('k'): CastlingRights |= EChessCastlingRights::BlackKingSide; break;
+		case TCHAR('q'): CastlingRights |= EChessCastlingRights::BlackQueenSide; break;
+		default: break;
+		}
+	}
+
+	// En passant target square
+	while (*Character == TCHAR(' ')) Character++;
+	if (*Character >= TCHAR('a') && *Character <= TCHAR('h') && Character[1] >= TCHAR('1') && Character[1] <= TCHAR('8'))
+	{
+		EnPassantSquare = static_cast<int8>(ChessBitboard::MakeSquare(Character[1] - TCHAR('1'), Character[0] - TCHAR('a')));
+		Character += 2;
+	}
+	else if (*Character)
+	{
+		Character++;
+	}
+
+	// Move counters are optional
+	while (*Character == TCHAR(' ')) Character++;
+	if (*Character) HalfmoveClock = static_cast<uint16>(FCString::Atoi(Character));
+
+	while (*Character && *Character != TCHAR(' ')) Character++;
+	while (*Character == TCHAR(' ')) Character++;
+	if (*Character) FullmoveNumber = static_cast<uint16>(FMath::Max(1, FCString::Atoi(Character)));
+
+	Key = ComputeKey();
+
+	return true;
+}
+
+FString FChessPosition::ToFen() const
+{
+	FString Fen;
+
+	for (int32 Rank = 7; Rank >= 0; Rank--)
+	{
+		int32 EmptySquares = 0;
+
+		for (int32 File = 0; File < 8; File++)
+		{
+			EChessColour::Type Colour;
+			EChessPiece::Type Piece;
+
+			if (!GetPieceOnSquare(ChessBitboard::MakeSquare(Rank, File), Colour, Piece))
+			{
+				EmptySquares++;
+				continue;
+			}
+
+			if (EmptySquares > 0) Fen.AppendChar(TCHAR('0' + EmptySquares));
+			EmptySquares = 0;
+
+			const TCHAR PieceCharacter = PieceFenCharacters[Piece];
+			Fen.AppendChar((Colour == EChessColour::White) ? TCHAR(PieceCharacter - TCHAR('a') + TCHAR('A')) : PieceCharacter);
+		}
+
+		if (EmptySquares > 0) Fen.AppendChar(TCHAR('0' + EmptySquares));
+		if (Rank > 0) Fen.AppendChar(TCHAR('/'));
+	}
+
+	Fen += (SideToMove == EChessColour::White) ? TEXT(" w ") : TEXT(" b ");
+
+	if (CastlingRights == EChessCastlingRights::None) Fen.AppendChar(TCHAR('-'));
+	if (HasCastlingRight(EChessCastlingRights::WhiteKingSide)) Fen.AppendChar(TCHAR('K'));
+	if (HasCastlingRight(EChessCastlingRights::WhiteQueenSide)) Fen.AppendChar(TCHAR('Q'));
+	if (HasCastlingRight(EChessCastlingRights::BlackKingSide)) Fen.AppendChar(TCHAR('k'));
+	if (HasCastlingRight(EChessCastlingRights::BlackQueenSide)) Fen.AppendChar(TCHAR('q'));
+
+	Fen.AppendChar(TCHAR(' '));
+
+	if (EnPassantSquare >= 0)
+	{
+		Fen.AppendChar(TCHAR('a' + ChessBitboard::GetFile(EnPassantSquare)));
+		Fen.AppendChar(TCHAR('1' + ChessBitboard::GetRank(EnPassantSquare)));
+	}
+	else
+	{
+		Fen.AppendChar(TCHAR('-'));
+	}
+
+	Fen += FString::Printf(TEXT(" %d %d"), static_cast<int32>(HalfmoveClock), static_cast<int32>(FullmoveNumber));
+
+	return Fen;
+}
+
+void FChessPosition::AddPiece(EChessColour::Type Colour, EChessPiece::Type Piece, int32 Square)
+{
+	const uint64 Mask = ChessBitboard::SquareMask(Square);
+
+	PieceBitboards[Colour][Piece] |= Mask;
+	ColourBitboards[Colour] |= Mask;
+	OccupiedBitboard |= Mask;
+	Mailbox[Square] = ChessMailbox::MakeCode(Colour, Piece);
+
+	Key ^= ChessZobrist::GetPieceKey(Colour, Piece, Square);
+
+	MiddlegameScore += ChessPieceSquare::GetMiddlegame(Colour, Piece, Square);
+	EndgameScore += ChessPieceSquare::GetEndgame(Colour, Piece, Square);
+	Phase += ChessPieceSquare::PhaseWeights[Piece];
+}
+
+void FChessPosition::RemovePiece(EChessColour::Type Colour, EChessPiece::Type Piece, int32 Square)
+{
+	const uint64 Mask = ~ChessBitboard::SquareMask(Square);
+
+	PieceBitboards[Colour][Piece] &= Mask;
+	ColourBitboards[Colour] &= Mask;
+	OccupiedBitboard &= Mask;
+	Mailbox[Square] = ChessMailbox::Empty;
+
+	Key ^= ChessZobrist::GetPieceKey(Colour, Piece, Square);
+
+	MiddlegameScore -= ChessPieceSquare::GetMiddlegame(Colour, Piece, Square);
+	EndgameScore -= ChessPieceSquare::GetEndgame(Colour, Piece, Square);
+	Phase -= ChessPieceSquare::PhaseWeights[Piece];
+}
+
+void FChessPosition::MovePiece(EChessColour::Type Colour, EChessPiece::Type Piece, int32 From, int32 To)
+{
+	const uint64 FromToMask = ChessBitboard::SquareMask(From) | ChessBitboard::SquareMask(To);
+
+	PieceBitboards[Colour][Piece] ^= FromToMask;
+	ColourBitboards[Colour] ^= FromToMask;
+	OccupiedBitboard ^= FromToMask;
+	Mailbox[From] = ChessMailbox::Empty;
+	Mailbox[To] = ChessMailbox::MakeCode(Colour, Piece);
+
+	Key ^= ChessZobrist::GetPieceKey(Colour, Piece, From) ^ ChessZobrist::GetPieceKey(Colour, Piece, To);
+
+	MiddlegameScore += ChessPieceSquare::GetMiddlegame(Colour, Piece, To) - ChessPieceSquare::GetMiddlegame(Colour, Piece, From);
+	EndgameScore += ChessPieceSquare::GetEndgame(Colour, Piece, To) - ChessPieceSquare::GetEndgame(Colour, Piece, From);
+}
+
+void FChessPosition::SetSideToMove(EChessColour::Type Colour)
+{
+	Key ^= GetEnPassantKey();
+	if (SideToMove != Colour) Key ^= ChessZobrist::GetBlackToMoveKey();
+
+	SideToMove = Colour;
+
+	Key ^= GetEnPassantKey();
+}
+
+void FChessPosition::SetCastlingRights(uint8 Rights)
+{
+	Key ^= ChessZobrist::GetCastlingKey(CastlingRights);
+
+	CastlingRights = Rights & EChessCastlingRights::All;
+
+	Key ^= ChessZobrist::GetCastlingKey(CastlingRights);
+}
+
+void FChessPosition::MakeMove(FChessMove Move, FChessUndoInfo& OutUndo)
+{
+	const int32 From = Move.GetFrom();
+	const int32 To = Move.GetTo();
+
+	const EChessColour::Type Us = SideToMove;
+	const EChessColour::Type Them = EChessColour::GetOpposite(Us);
+	const EChessPiece::Type MovingPiece = GetPieceTypeOnSquare(From);
+
+	checkSlow(MovingPiece != EChessPiece::None);
+
+	OutUndo.CapturedPiece = EChessPiece::None;
+	OutUndo.CastlingRights = CastlingRights;
+	OutUndo.EnPassantSquare = EnPassantSquare;
+	OutUndo.HalfmoveClock = HalfmoveClock;
+	OutUndo.Key = Key;
+
+	// State keys come out before anything changes and go back in once the move is done
+	Key ^= GetEnPassantKey() ^ ChessZobrist::GetCastlingKey(CastlingRights);
+
+	HalfmoveClock++;
+
+	if (Move.IsCapture())
+	{
+		const int32 CapturedSquare = Move.IsEnPassant() ? ((Us == EChessColour::White) ? To - 8 : To + 8) : To;
+		OutUndo.CapturedPiece = GetPieceTypeOnSquare(CapturedSquare);
+		RemovePiece(Them, OutUndo.CapturedPiece, CapturedSquare);
+		HalfmoveClock = 0;
+	}
+
+	if (Move.IsPromotion())
+	{
+		RemovePiece(Us, EChessPiece::Pawn, From);
+		AddPiece(Us, Move.GetPromotionPiece(), To);
+	}
+	else
+	{
+		MovePiece(Us, MovingPiece, From, To);
+	}
+
+	if (MovingPiece == EChessPiece::Pawn) HalfmoveClock = 0;
+
+	// Castling moves the rook alongside the king
+	if (Move.GetFlag() == EChessMoveFlag::KingCastle) MovePiece(Us, EChessPiece::Rook, To + 1, To - 1);
+	else if (Move.GetFlag() == EChessMoveFlag::QueenCastle) MovePiece(Us, EChessPiece::Rook, To - 2, To + 1);
+
+	EnPassantSquare = (Move.GetFlag() == EChessMoveFlag::DoublePawnPush) ? static_cast<int8>((From + To) / 2) : -1;
+
+	CastlingRights &= CastlingRightsMask[From] & CastlingRightsMask[To];
+
+	if (Us == EChessColour::Black) FullmoveNumber++;
+
+	SideToMove = Them;
+
+	Key ^= GetEnPassantKey() ^ ChessZobrist::GetCastlingKey(CastlingRights) ^ ChessZobrist::GetBlackToMoveKey();
+}
+
+void FChessPosition::UnmakeMove(FChessMove Move, const FChessUndoInfo& Undo)
+{
+	const int32 From = Move.GetFrom();
+	const int32 To = Move.GetTo();
+
+	const EChessColour::Type Them = SideToMove;
+	const EChessColour::Type Us = EChessColour::GetOpposite(Them);
+
+	SideToMove = Us;
+
+	if (Us == EChessColour::Black) FullmoveNumber--;
+
+	if (Move.GetFlag() == EChessMoveFlag::KingCastle) MovePiece(Us, EChessPiece::Rook, To - 1, To + 1);
+	else if (Move.GetFlag() == EChessMoveFlag::QueenCastle) MovePiece(Us, EChessPiece::Rook, To + 1, To - 2);
+
+	if (Move.IsPromotion())
+	{
+		RemovePiece(Us, Move.GetPromotionPiece(), To);
+		AddPiece(Us, EChessPiece::Pawn, From);
+	}
+	else
+	{
+		MovePiece(Us, GetPieceTypeOnSquare(To), To, From);
+	}
+
+	if (Undo.CapturedPiece != EChessPiece::None)
+	{
+		const int32 CapturedSquare = Move.IsEnPassant() ? ((Us == EChessColour::White) ? To - 8 : To + 8) : To;
+		AddPiece(Them, Undo.CapturedPiece, CapturedSquare);
+	}
+
+	CastlingRights = Undo.CastlingRights;
+	EnPassantSquare = Undo.EnPassantSquare;
+	HalfmoveClock = Undo.HalfmoveClock;
+	Key = Undo.Key;
+}
+
+uint64 FChessPosition::GetAttackersTo(int32 Square, uint64 Occupied) const
+{
+	return (ChessBitboard::GetPawnAttacks(false, Square) & PieceBitboards[EChessColour::White][EChessPiece::Pawn])
+		| (ChessBitboard::GetPawnAttacks(true, Square) & PieceBitboards[EChessColour::Black][EChessPiece::Pawn])
+		| (ChessBitboard::GetKnightAttacks(Square) & GetPieces(EChessPiece::Knight))
+		| (ChessBitboard::GetKingAttacks(Square) & GetPieces(EChessPiece::King))
+		| (ChessBitboard::GetRookAttacks(Square, Occupied) & (GetPieces(EChessPiece::Rook) | GetPieces(EChessPiece::Queen)))
+		| (ChessBitboard::GetBishopAttacks(Square, Occupied) & (GetPieces(EChessPiece::Bishop) | GetPieces(EChessPiece::Queen)));
+}
+
+bool FChessPosition::IsSquareAttacked(int32 Square, EChessColour::Type ByColour) const
+{
+	const uint64* Pieces = PieceBitboards[ByColour];
+
+	// a pawn of ByColour attacks Square if a pawn of the other colour on Square would attack it back
+	if (ChessBitboard::GetPawnAttacks(ByColour != EChessColour::White, Square) & Pieces[EChessPiece::Pawn]) return true;
+	if (ChessBitboard::GetKnightAttacks(Square) & Pieces[EChessPiece::Knight]) return true;
+	if (ChessBitboard::GetKingAttacks(Square) & Pieces[EChessPiece::King]) return true;
+	if (ChessBitboard::GetRookAttacks(Square, OccupiedBitboard) & (Pieces[EChessPiece::Rook] | Pieces[EChessPiece::Queen])) return true;
+	if (ChessBitboard::GetBishopAttacks(Square, OccupiedBitboard) & (Pieces[EChessPiece::Bishop] | Pieces[EChessPiece::Queen])) return true;
+
+	return false;
+}
+
+uint64 FChessPosition::ComputeKey() const
+{
+	uint64 NewKey = 0;
+
+	for (int32 Colour = 0; Colour < EChessColour::Num; Colour++)
+	{
+		for (int32 Piece = 0; Piece < EChessPiece::Num; Piece++)
+		{
+			for (uint64 Pieces = PieceBitboards[Colour][Piece]; Pieces;)
+				NewKey ^= ChessZobrist::GetPieceKey(static_cast<EChessColour::Type>(Colour), static_cast<EChessPiece::Type>(Piece), ChessBitboard::PopLeastSignificantSquare(Pieces));
+		}
+	}
+
+	NewKey ^= ChessZobrist::GetCastlingKey(CastlingRights) ^ GetEnPassantKey();
+
+	if (SideToMove == EChessColour::Black) NewKey ^= ChessZobrist::GetBlackToMoveKey();
+
+	return NewKey;
+}
+
+uint64 FChessPosition::GetEnPassantKey() const
+{
+	if (EnPassantSquare < 0) return 0;
+
+	// a pawn of the side to move captures en passant if a pawn of the other colour on the target square would attack it
+	const bool bCanCapture = (ChessBitboard::GetPawnAttacks(SideToMove != EChessColour::White, EnPassantSquare) & PieceBitboards[SideToMove][EChessPiece::Pawn]) != 0;
+
+	return bCanCapture ? ChessZobrist::GetEnPassantKey(EnPassantSquare) : 0;
+}
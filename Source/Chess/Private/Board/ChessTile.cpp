@@ -7,13 +7,13 @@
 #include "Core/ChessPlayerController.h"
 
 #include "Kismet/GameplayStatics.h"
-#include "Kismet/KismetMaterialLibrary.h"
 
 #define PRINTSTRING(Colour, DebugMessage) GEngine->AddOnScreenDebugMessage(INDEX_NONE, 3.f, Colour, DebugMessage);
 
 AChessTile::AChessTile()
 {
-	PrimaryActorTick.bCanEverTick = true;
+	// A tile only changes when the board tells it to
+	PrimaryActorTick.bCanEverTick = false;
 
 	// DefaultSceneRootComponent
 	DefaultSceneRootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("DefaultSceneRootComponent"));
@@ -27,7 +27,7 @@ AChessTile::AChessTile()
 	static ConstructorHelpers::FObjectFinder<UStaticMesh> ChessTileMeshAsset(TEXT("/Script/Engine.StaticMesh'/Game/Assets/Meshes/SM_ChessTile.SM_ChessTile'"));
 	if (ChessTileMeshAsset.Succeeded()) ChessTileMesh->SetStaticMesh(ChessTileMeshAsset.Object);
 
-	static ConstructorHelpers::FObjectFinder<UMaterialInterface> TileMaterialAsset(TEXT("/Script/Engine.MaterialInstanceConstant'/Game/+Chess/Materials/ChessTile/M_ChessTile.M_ChessTile'"));
+	static ConstructorHelpers::FObjectFinder<UMaterialInterface> TileMaterialAsset(TEXT("/Script/Engine.Material'/Game/+Chess/Materials/ChessTile/M_ChessTile.M_ChessTile'"));
 	if (TileMaterialAsset.Succeeded()) TileMaterial = TileMaterialAsset.Object;
 }
 
@@ -35,16 +35,16 @@ void AChessTile::OnConstruction(const FTransform& Transform)
 {
 	Super::OnConstruction(Transform);
 
-	if (TileMaterial)
+	// Drawn and picked through the board's tile instances, without a mesh this component has no render proxy or collision
+	if (bRenderedByBoard)
 	{
-		TileMaterialInstanceDynamic = UKismetMaterialLibrary::CreateDynamicMaterialInstance(this, TileMaterial);
-		if (TileMaterialInstanceDynamic)
-		{
-			ChessTileMesh->SetMaterial(0, TileMaterialInstanceDynamic);
-
-			TileMaterialInstanceDynamic->SetVectorParameterValue("Colour", (ChessTileInfo.bIsWhite) ? FLinearColor::White : FLinearColor::Black);
-		}
+		ChessTileMesh->SetStaticMesh(nullptr);
+		return;
 	}
+
+	if (TileMaterial) ChessTileMesh->SetMaterial(0, TileMaterial);
+
+	ChessTileMesh->SetCustomPrimitiveDataVector4(EChessTileCustomData::Red, GetCustomData(ChessTileInfo.bIsWhite, ChessTileInfo.bIsHighlighted));
 }
 
 void AChessTile::BeginPlay()
@@ -52,17 +52,16 @@ void AChessTile::BeginPlay()
 	Super::BeginPlay();
 }
 
-void AChessTile::Tick(float DeltaTime)
-{
-	Super::Tick(DeltaTime);
-}
-
 void AChessTile::HighlightTile(bool bHighlight)
 {
-	if (bHighlight)
-		TileMaterialInstanceDynamic->SetVectorParameterValue("Colour", FLinearColor::Green);
-	else
-		TileMaterialInstanceDynamic->SetVectorParameterValue("Colour", (ChessTileInfo.bIsWhite) ? FLinearColor::White : FLinearColor::Black);
+	// Only the primitive's data changes, the tile keeps sharing TileMaterial
+	ChessTileMesh->SetCustomPrimitiveDataVector4(EChessTileCustomData::Red, GetCustomData(ChessTileInfo.bIsWhite, bHighlight));
 
 	ChessTileInfo.bIsHighlighted = bHighlight;
+}
+
+FVector4 AChessTile::GetCustomData(bool bIsWhite, bool bIsHighlighted)
+{
+	const FLinearColor Colour = bIsHighlighted ? FLinearColor::Green : (bIsWhite ? FLinearColor::White : FLinearColor::Black);
+	return FVector4(Colour.R, Colour.G, Colour.B, bIsHighlighted ? 1.f : 0.f);
 }
\ No newline at end of file
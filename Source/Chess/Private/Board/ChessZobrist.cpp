@@ -0,0 +1,48 @@
+// Copyright Kunal Patil (kroxyserver). All Rights Reserved.
+
+#include "Board/ChessZobrist.h"
+
+namespace ChessZobrist
+{
+	namespace Keys
+	{
+		uint64 Pieces[EChessColour::Num][EChessPiece::Num][64];
+		uint64 Castling[16];
+		uint64 EnPassantFile[8];
+		uint64 BlackToMove;
+	}
+
+	void InitializeKeys()
+	{
+		// splitmix64, fixed seed so keys are identical between runs and builds
+		uint64 State = 0x9E3779B97F4A7C15ULL;
+
+		auto NextKey = [&State]() -> uint64
+		{
+			uint64 Key = (State += 0x9E3779B97F4A7C15ULL);
+			Key = (Key ^ (Key >> 30)) * 0xBF58476D1CE4E5B9ULL;
+			Key = (Key ^ (Key >> 27)) * 0x94D049BB133111EBULL;
+			return Key ^ (Key >> 31);
+		};
+
+		for (int32 Colour = 0; Colour < EChessColour::Num; Colour++)
+			for (int32 Piece = 0; Piece < EChessPiece::Num; Piece++)
+				for (int32 Square = 0; Square < 64; Square++)
+					Keys::Pieces[Colour][Piece][Square] = NextKey();
+
+		// One key per right, combinations are XORs of the single rights so removing a right is one XOR either way
+		uint64 RightKeys[4];
+		for (uint64& RightKey : RightKeys) RightKey = NextKey();
+
+		for (int32 Rights = 0; Rights < 16; Rights++)
+		{
+			Keys::Castling[Rights] = 0;
+			for (int32 Right = 0; Right < 4; Right++)
+				if (Rights & (1 << Right)) Keys::Castling[Rights] ^= RightKeys[Right];
+		}
+
+		for (uint64& FileKey : Keys::EnPassantFile) FileKey = NextKey();
+
+		Keys::BlackToMove = NextKey();
+	}
+}
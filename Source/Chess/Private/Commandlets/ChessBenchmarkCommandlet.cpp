@@ -0,0 +1,243 @@
+// Copyright Kunal Patil (kroxyserver). All Rights Reserved.
+
+#include "Commandlets/ChessBenchmarkCommandlet.h"
+
+#include "Chess/Chess.h"
+
+#include "AI/ChessEvaluation.h"
+#include "AI/ChessNeuralNetwork.h"
+#include "AI/ChessSearch.h"
+#include "AI/ChessTranspositionTable.h"
+#include "Board/ChessMoveGenerator.h"
+#include "Board/ChessPosition.h"
+
+#include "HAL/PlatformTime.h"
+
+namespace
+{
+	// Opening, middlegame and endgame positions so the numbers aren't dominated by one phase
+	const TCHAR* BenchmarkFens[] =
+	{
+		TEXT("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"),
+		TEXT("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1"),
+		TEXT("r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10"),
+		TEXT("r1bq1rk1/pp2bppp/2n1pn2/3p4/2PP4/2N1PN2/PP1QBPPP/R3KB1R w KQ - 0 9"),
+		TEXT("2r3k1/pp3ppp/4p3/3pP3/3P4/P4N2/1P3PPP/2R3K1 w - - 0 25"),
+		TEXT("8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1"),
+		TEXT("8/8/4k3/3p4/3P4/4K3/8/8 w - - 0 1"),
+	};
+}
+
+UChessBenchmarkCommandlet::UChessBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UChessBenchmarkCommandlet::Main(const FString& Params)
+{
+	FString Mode = TEXT("Search");
+	FParse::Value(*Params, TEXT("Mode="), Mode);
+
+	if (Mode == TEXT("Search")) return RunSearchBenchmark(Params);
+	if (Mode == TEXT("Evaluation")) return RunEvaluationBenchmark(Params);
+
+	UE_LOG(LogChess, Error, TEXT("Unknown benchmark mode : %s"), *Mode);
+	return 1;
+}
+
+int32 UChessBenchmarkCommandlet::RunSearchBenchmark(const FString& Params) const
+{
+	int32 Depth = 8;
+	FParse::Value(*Params, TEXT("Depth="), Depth);
+	Depth = FMath::Clamp(Depth, 1, ChessSearch::MaxPly - 1);
+
+	int32 NumThreads = FPlatformMisc::NumberOfCoresIncludingHyperthreads();
+	FParse::Value(*Params, TEXT("Threads="), NumThreads);
+	NumThreads = FMath::Clamp(NumThreads, 1, ChessSearch::MaxThreads);
+
+	int32 HashSizeMB = 64;
+	FParse::Value(*Params, TEXT("HashMB="), HashSizeMB);
+	HashSizeMB = FMath::Max(HashSizeMB, 1);
+
+	UE_LOG(LogChess, Display, TEXT("Search benchmark : %d positions, depth %d, %d MB hash"), UE_ARRAY_COUNT(BenchmarkFens), Depth, HashSizeMB);
+
+	const FChessSearchResult Single = SearchBenchmarkPositions(Depth, 1, HashSizeMB);
+
+	UE_LOG(LogChess, Display, TEXT("1 thread   : %llu nodes in %.3fs (%.0f nodes/s)"), Single.Nodes, Single.ElapsedSeconds, Single.Nodes / FMath::Max(Single.ElapsedSeconds, 1e-9));
+	UE_LOG(LogChess, Display, TEXT("Move ordering : effective branching factor %.2f (mean over positions), %.1f%% of cutoffs on the first move"),
+		Single.EffectiveBranchingFactor, Single.OrderingStats.BetaCutoffs ? 100.0 * Single.OrderingStats.FirstMoveCutoffs / Single.OrderingStats.BetaCutoffs : 0.0);
+	UE_LOG(LogChess, Display, TEXT("Quiescence : %llu nodes (%.1f%%), %llu stand pat cutoffs, %llu losing captures pruned"),
+		Single.QuiescenceStats.Nodes, Single.Nodes ? 100.0 * Single.QuiescenceStats.Nodes / Single.Nodes : 0.0, Single.QuiescenceStats.StandPatCutoffs, Single.QuiescenceStats.PrunedCaptures);
+
+	if (NumThreads > 1)
+	{
+		const FChessSearchResult Parallel = SearchBenchmarkPositions(Depth, NumThreads, HashSizeMB);
+
+		UE_LOG(LogChess, Display, TEXT("%d threads : %llu nodes in %.3fs (%.0f nodes/s)"), NumThreads, Parallel.Nodes, Parallel.ElapsedSeconds, Parallel.Nodes / FMath::Max(Parallel.ElapsedSeconds, 1e-9));
+
+		// Time to depth is what Lazy SMP actually buys, nodes per second alone overstates it since helpers repeat work
+		UE_LOG(LogChess, Display, TEXT("Time to depth speedup : %.2fx, nodes/s speedup : %.2fx"),
+			Single.ElapsedSeconds / FMath::Max(Parallel.ElapsedSeconds, 1e-9),
+			(Parallel.Nodes / FMath::Max(Parallel.ElapsedSeconds, 1e-9)) / FMath::Max(Single.Nodes / FMath::Max(Single.ElapsedSeconds, 1e-9), 1e-9));
+	}
+
+	return 0;
+}
+
+FChessSearchResult UChessBenchmarkCommandlet::SearchBenchmarkPositions(int32 Depth, int32 NumThreads, int32 HashSizeMB) const
+{
+	FChessTranspositionTable TranspositionTable(HashSizeMB);
+
+	FChessSearchLimits Limits;
+	Limits.MaxDepth = Depth;
+	Limits.NumThreads = NumThreads;
+
+	FChessSearchResult Total;
+
+	for (const TCHAR* Fen : BenchmarkFens)
+	{
+		FChessPosition Position;
+		Position.SetFromFen(Fen);
+
+		// Every position starts cold so the runs are comparable
+		TranspositionTable.Clear();
+		TranspositionTable.NewSearch();
+
+		FChessSearch Search;
+		Search.SetTranspositionTable(&TranspositionTable);
+
+		const FChessSearchResult Result = Search.Search(Position, Limits);
+
+		UE_LOG(LogChess, Verbose, TEXT("  %s : %s, score %d, depth %d, %llu nodes in %.3fs, branching factor %.2f"), Fen, *Result.BestMove.ToString(), Result.Score, Result.Depth, Result.Nodes, Result.ElapsedSeconds, Result.EffectiveBranchingFactor);
+
+		Total.Nodes += Result.Nodes;
+		Total.QuiescenceStats += Result.QuiescenceStats;
+		Total.OrderingStats += Result.OrderingStats;
+		Total.EffectiveBranchingFactor += Result.EffectiveBranchingFactor / UE_ARRAY_COUNT(BenchmarkFens);
+		Total.ElapsedSeconds += Result.ElapsedSeconds;
+	}
+
+	return Total;
+}
+
+int32 UChessBenchmarkCommandlet::RunEvaluationBenchmark(const FString& Params) const
+{
+	double MinSeconds = 2.0;
+	FParse::Value(*Params, TEXT("Seconds="), MinSeconds);
+
+	FChessNeuralNetwork NeuralNetwork;
+
+	FString NetworkFile;
+	if (FParse::Value(*Params, TEXT("Network="), NetworkFile))
+	{
+		if (!NeuralNetwork.LoadFromFile(NetworkFile)) return 1;
+	}
+	else
+	{
+		// Throughput doesn't depend on the weights, only the checksum does
+		UE_LOG(LogChess, Display, TEXT("No -Network= given, timing the network with random weights"));
+		NeuralNetwork.InitializeRandom(0x5EED);
+	}
+
+	// Every position two plies from the set, a few thousand positions covering all phases
+	// The network is timed both from the parent's accumulator as in the search and rebuilt from scratch
+	TArray<FChessPosition> Parents;
+	TArray<FChessAccumulator> ParentAccumulators;
+	TArray<TPair<int32, FChessMove>> Replies;
+	TArray<FChessPosition> Positions;
+
+	for (const TCHAR* Fen : BenchmarkFens)
+	{
+		FChessPosition Root;
+		Root.SetFromFen(Fen);
+
+		FChessMoveList Moves;
+		FChessMoveGenerator::GenerateLegalMoves(Root, Moves);
+
+		for (const FChessMove& Move : Moves)
+		{
+			const int32 ParentIndex = Parents.Add(Root);
+			Parents[ParentIndex].ApplyMove(Move);
+			NeuralNetwork.RefreshAccumulator(Parents[ParentIndex], ParentAccumulators.AddDefaulted_GetRef());
+
+			FChessMoveList ParentMoves;
+			FChessMoveGenerator::GenerateLegalMoves(Parents[ParentIndex], ParentMoves);
+
+			for (const FChessMove& Reply : ParentMoves)
+			{
+				Replies.Add(TPair<int32, FChessMove>(ParentIndex, Reply));
+				Positions.Add_GetRef(Parents[ParentIndex]).ApplyMove(Reply);
+			}
+		}
+	}
+
+	// Runs Pass over every position until MinSeconds have gone by, the checksum keeps the work from being optimised away
+	auto Measure = [&](const TCHAR* Name, TFunctionRef<int64()> Pass) -> double
+	{
+		uint64 Evaluations = 0;
+		int64 Checksum = 0;
+		int32 Passes = 0;
+
+		const double StartTime = FPlatformTime::Seconds();
+		double Seconds = 0.0;
+
+		do
+		{
+			Checksum = Pass();
+			Evaluations += Positions.Num();
+			Passes++;
+			Seconds = FPlatformTime::Seconds() - StartTime;
+		} while (Seconds < MinSeconds);
+
+		const double EvaluationsPerSecond = Evaluations / FMath::Max(Seconds, 1e-9);
+
+		UE_LOG(LogChess, Display, TEXT("%-22s : %.0f evals/s, %.1f ns/eval, checksum %lld"), Name, EvaluationsPerSecond, 1e9 / FMath::Max(EvaluationsPerSecond, 1e-9), Checksum);
+
+		return EvaluationsPerSecond;
+	};
+
+	UE_LOG(LogChess, Display, TEXT("Evaluation benchmark : %d positions, network inference using %s"), Positions.Num(), FChessNeuralNetwork::GetSimdName());
+
+	const double HandCrafted = Measure(TEXT("Hand crafted"), [&Positions]()
+	{
+		int64 Checksum = 0;
+		for (const FChessPosition& Position : Positions) Checksum += FChessEvaluation::Evaluate(Position);
+		return Checksum;
+	});
+
+	const double Incremental = Measure(TEXT("Network, incremental"), [&]()
+	{
+		int64 Checksum = 0;
+		FChessAccumulator Accumulator;
+
+		for (const TPair<int32, FChessMove>& Reply : Replies)
+		{
+			const FChessPosition& Parent = Parents[Reply.Key];
+			NeuralNetwork.UpdateAccumulator(ParentAccumulators[Reply.Key], Accumulator, Parent, Reply.Value);
+			Checksum += NeuralNetwork.Evaluate(Accumulator, EChessColour::GetOpposite(Parent.GetSideToMove()));
+		}
+
+		return Checksum;
+	});
+
+	const double Refresh = Measure(TEXT("Network, full refresh"), [&]()
+	{
+		int64 Checksum = 0;
+		FChessAccumulator Accumulator;
+
+		for (const FChessPosition& Position : Positions)
+		{
+			NeuralNetwork.RefreshAccumulator(Position, Accumulator);
+			Checksum += NeuralNetwork.Evaluate(Accumulator, Position.GetSideToMove());
+		}
+
+		return Checksum;
+	});
+
+	UE_LOG(LogChess, Display, TEXT("Network relative to hand crafted : %.2fx incremental, %.2fx full refresh"), Incremental / FMath::Max(HandCrafted, 1e-9), Refresh / FMath::Max(HandCrafted, 1e-9));
+
+	return 0;
+}
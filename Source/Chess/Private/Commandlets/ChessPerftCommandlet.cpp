@@ -0,0 +1,104 @@
+// Copyright Kunal Patil (kroxyserver). All Rights Reserved.
+
+#include "Commandlets/ChessPerftCommandlet.h"
+
+#include "Chess/Chess.h"
+
+#include "Board/ChessPerft.h"
+#include "Board/ChessPosition.h"
+
+#include "HAL/PlatformTime.h"
+
+UChessPerftCommandlet::UChessPerftCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UChessPerftCommandlet::Main(const FString& Params)
+{
+	int32 MaxDepth = 5;
+	FParse::Value(*Params, TEXT("Depth="), MaxDepth);
+	MaxDepth = FMath::Max(MaxDepth, 1);
+
+	const bool bDivide = FParse::Param(*Params, TEXT("Divide"));
+
+	// Single position, nothing to compare against
+	FString Fen;
+	if (FParse::Value(*Params, TEXT("Fen="), Fen, false))
+	{
+		FChessPosition Position;
+		if (!Position.SetFromFen(Fen.TrimQuotes()))
+		{
+			UE_LOG(LogChess, Error, TEXT("Invalid FEN : %s"), *Fen);
+			return 1;
+		}
+
+		double Seconds = 0.0;
+		const uint64 Nodes = RunPerft(Position, MaxDepth, bDivide, Seconds);
+
+		UE_LOG(LogChess, Display, TEXT("Depth %d : %llu nodes in %.3fs (%.0f nodes/s)"), MaxDepth, Nodes, Seconds, Nodes / FMath::Max(Seconds, 1e-9));
+		return 0;
+	}
+
+	int32 Failures = 0;
+	uint64 TotalNodes = 0;
+	double TotalSeconds = 0.0;
+
+	for (const FChessPerftCase& Case : FChessPerft::GetStandardSuite())
+	{
+		FChessPosition Position;
+		Position.SetFromFen(Case.Fen);
+
+		const int32 Depth = FMath::Min(MaxDepth, Case.ExpectedNodes.Num());
+
+		double Seconds = 0.0;
+		const uint64 Nodes = RunPerft(Position, Depth, bDivide, Seconds);
+		const uint64 Expected = Case.ExpectedNodes[Depth - 1];
+
+		TotalNodes += Nodes;
+		TotalSeconds += Seconds;
+
+		if (Nodes == Expected)
+		{
+			UE_LOG(LogChess, Display, TEXT("%-24s depth %d : %llu nodes in %.3fs (%.0f nodes/s)"), Case.Name, Depth, Nodes, Seconds, Nodes / FMath::Max(Seconds, 1e-9));
+		}
+		else
+		{
+			UE_LOG(LogChess, Error, TEXT("%-24s depth %d : %llu nodes, expected %llu"), Case.Name, Depth, Nodes, Expected);
+			Failures++;
+		}
+	}
+
+	UE_LOG(LogChess, Display, TEXT("Total : %llu nodes in %.3fs (%.0f nodes/s), %d failed"), TotalNodes, TotalSeconds, TotalNodes / FMath::Max(TotalSeconds, 1e-9), Failures);
+
+	return Failures > 0 ? 1 : 0;
+}
+
+uint64 UChessPerftCommandlet::RunPerft(FChessPosition& Position, int32 Depth, bool bDivide, double& OutSeconds) const
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	uint64 Nodes = 0;
+
+	if (bDivide)
+	{
+		TArray<FChessPerftDivideEntry> Entries;
+		Nodes = FChessPerft::Divide(Position, Depth, Entries);
+
+		OutSeconds = FPlatformTime::Seconds() - StartTime;
+
+		for (const FChessPerftDivideEntry& Entry : Entries)
+			UE_LOG(LogChess, Display, TEXT("  %s : %llu"), *Entry.Move.ToString(), Entry.Nodes);
+	}
+	else
+	{
+		Nodes = FChessPerft::Perft(Position, Depth);
+
+		OutSeconds = FPlatformTime::Seconds() - StartTime;
+	}
+
+	return Nodes;
+}
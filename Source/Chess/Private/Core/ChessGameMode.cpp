@@ -2,10 +2,20 @@
 
 #include "Core/ChessGameMode.h"
 
+#include "Chess/Chess.h"
+
+#include "AI/ChessAnalysis.h"
+#include "AI/ChessAsyncSearch.h"
+#include "AI/ChessOpeningBook.h"
 #include "Board/ChessBoard.h"
+#include "Board/ChessMoveGenerator.h"
+#include "Board/ChessPiece.h"
+#include "Board/ChessTile.h"
 #include "Core/ChessGameInstance.h"
 #include "Core/ChessPlayer.h"
 #include "Core/ChessPlayerController.h"
+#include "Data/ChessAISettings.h"
+#include "Data/ChessBoardData.h"
 
 #include "Engine/TargetPoint.h"
 #include "Kismet/GameplayStatics.h"
@@ -20,6 +30,10 @@ AChessGameMode::AChessGameMode() :
 {
 	DefaultPawnClass = AChessPlayer::StaticClass();
 	PlayerControllerClass = AChessPlayerController::StaticClass();
+
+	// Only ticks while analysing, to hand the analysis results to the UI
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
 }
 
 void AChessGameMode::OnConstruction(const FTransform& Transform)
@@ -27,6 +41,42 @@ void AChessGameMode::OnConstruction(const FTransform& Transform)
 	Super::OnConstruction(Transform);
 }
 
+void AChessGameMode::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	if (!Analysis.IsValid()) return;
+
+	// However many iterations finished since the last frame, the UI only rebuilds for the newest
+	FChessSearchResult Result;
+	if (!Analysis->DrainLatest(Result)) return;
+
+	const int32 Sign = (Analysis->GetPosition().GetSideToMove() == EChessColour::White) ? 1 : -1;
+
+	TArray<FChessAnalysisLine> Lines;
+
+	for (const FChessSearchLine& SearchLine : Result.Lines)
+	{
+		FChessAnalysisLine& Line = Lines.AddDefaulted_GetRef();
+		Line.Depth = SearchLine.Depth;
+		Line.Score = Sign * SearchLine.Score;
+
+		if (ChessSearch::IsMateScore(SearchLine.Score))
+		{
+			const int32 MatePlies = ChessSearch::MateScore - FMath::Abs(SearchLine.Score);
+			Line.MateIn = Sign * ((SearchLine.Score > 0) ? (MatePlies + 1) / 2 : -MatePlies / 2);
+		}
+
+		for (const FChessMove& Move : SearchLine.PrincipalVariation)
+		{
+			if (!Line.Moves.IsEmpty()) Line.Moves += TEXT(" ");
+			Line.Moves += Move.ToString();
+		}
+	}
+
+	OnAnalysisUpdated.Broadcast(Lines);
+}
+
 void AChessGameMode::BeginPlay()
 {
 	Super::BeginPlay();
@@ -55,6 +105,8 @@ void AChessGameMode::BeginPlay()
 	{
 		ChessBoard = GetWorld()->SpawnActor<AChessBoard>(ChessBoardClass, OutActors[0]->GetActorTransform());
 		if (!ChessBoard) return PRINTSTRING(FColor::Red, "ChessBoard is Invalid in GameMode");
+
+		ChessBoard->OnPositionChanged.AddDynamic(this, &AChessGameMode::OnBoardPositionChanged);
 	}
 
 
@@ -64,7 +116,12 @@ void AChessGameMode::BeginPlay()
 	switch (ChessGameModeType)
 	{
 	case EChessGameModeType::Player_VS_AI:
+		AITranspositionTable = MakeShared<FChessTranspositionTable, ESPMode::ThreadSafe>(GetDefault<UChessAISettings>()->TranspositionTableSizeMB);
+		LoadAINeuralNetwork();
+		LoadAIOpeningBook();
+		AIClockSeconds = GetDefault<UChessAISettings>()->ClockTime;
 		ChessPlayerController->bIsPlayerTurn = UKismetMathLibrary::RandomBool();
+		if (!ChessPlayerController->bIsPlayerTurn) GetWorldTimerManager().SetTimerForNextTick(this, &AChessGameMode::PlayAITurn);
 		break;
 	case EChessGameModeType::Player_VS_Player:
 		ChessPlayerController->bIsPlayerTurn = true;
@@ -74,6 +131,28 @@ void AChessGameMode::BeginPlay()
 	}
 }
 
+void AChessGameMode::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// the workers only touch their own snapshots, but they must be gone before the module can unload
+	for (TSharedPtr<FChessAsyncSearch, ESPMode::ThreadSafe>* Search : { &AISearch, &AIPonderSearch })
+	{
+		if (!Search->IsValid()) continue;
+
+		(*Search)->Cancel();
+		(*Search)->Wait();
+		Search->Reset();
+	}
+
+	if (Analysis.IsValid())
+	{
+		Analysis->Stop();
+		Analysis->Wait();
+		Analysis.Reset();
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void AChessGameMode::SwitchTurn()
 {
 	bIsWhiteTurn = !bIsWhiteTurn;
@@ -87,10 +166,9 @@ void AChessGameMode::SwitchTurn()
 	case EChessGameModeType::Player_VS_AI:
 		if (!ChessPlayerController) return PRINTSTRING(FColor::Red, "ChessPlayerController is Invalid in GameMode");
 		ChessPlayerController->bIsPlayerTurn = !ChessPlayerController->bIsPlayerTurn;
-		
-		//TODO : MORE CODE NEEDED HERE FOR AI FUNCTIONALITY
-
 
+		// next tick so the player's move is on screen before the AI starts thinking, or once the player has picked their promotion piece
+		if (!ChessPlayerController->bIsPlayerTurn && !bIsAwaitingPromotion) GetWorldTimerManager().SetTimerForNextTick(this, &AChessGameMode::PlayAITurn);
 		break;
 	case EChessGameModeType::Player_VS_Player:
 		if (!ChessPlayer) return PRINTSTRING(FColor::Red, "ChessPlayer is Invalid in GameMode");
@@ -99,4 +177,302 @@ void AChessGameMode::SwitchTurn()
 	default:
 		break;
 	}
+}
+
+void AChessGameMode::StartAnalysis()
+{
+	if (!ChessBoard) return PRINTSTRING(FColor::Red, "ChessBoard is Invalid in GameMode");
+
+	// Restarting, the old search winds down on its own and its queued lines are dropped with it
+	if (Analysis.IsValid()) Analysis->Stop();
+
+	// Player vs player games have no AI table yet, analysis benefits from one all the same
+	if (!AITranspositionTable.IsValid()) AITranspositionTable = MakeShared<FChessTranspositionTable, ESPMode::ThreadSafe>(GetDefault<UChessAISettings>()->TranspositionTableSizeMB);
+
+	// No clock and no time limit, the analysis runs until stopped or the depth runs out
+	FChessSearchLimits Limits;
+	Limits.NumThreads = MakeAISearchLimits().NumThreads;
+	Limits.MultiPV = GetDefault<UChessAISettings>()->AnalysisLines;
+
+	Analysis = MakeShared<FChessAnalysis, ESPMode::ThreadSafe>(ChessBoard->Position, Limits, ChessBoard->PositionKeyHistory, AITranspositionTable, AINeuralNetwork);
+	Analysis->Start();
+
+	// Restarts keep the tick they already have, the board counts it once
+	if (!IsActorTickEnabled())
+	{
+		SetActorTickEnabled(true);
+		ChessBoard->SetTicking(true);
+	}
+}
+
+void AChessGameMode::StopAnalysis()
+{
+	if (IsActorTickEnabled())
+	{
+		SetActorTickEnabled(false);
+		if (ChessBoard) ChessBoard->SetTicking(false);
+	}
+
+	if (!Analysis.IsValid()) return;
+
+	Analysis->Stop();
+	Analysis.Reset();
+}
+
+bool AChessGameMode::IsAnalysing() const
+{
+	return Analysis.IsValid();
+}
+
+void AChessGameMode::OnBoardPositionChanged()
+{
+	if (Analysis.IsValid()) StartAnalysis();
+
+	// Only the promotion itself changes the position while one is awaited, the move came before the flag was set
+	if (bIsAwaitingPromotion)
+	{
+		bIsAwaitingPromotion = false;
+
+		if (ChessGameModeType == EChessGameModeType::Player_VS_AI && ChessPlayerController && !ChessPlayerController->bIsPlayerTurn)
+			GetWorldTimerManager().SetTimerForNextTick(this, &AChessGameMode::PlayAITurn);
+	}
+}
+
+void AChessGameMode::LoadAINeuralNetwork()
+{
+	AINeuralNetwork.Reset();
+
+	if (!ChessBoard || !ChessBoard->ChessBoardData || ChessBoard->ChessBoardData->NeuralNetworkFile.FilePath.IsEmpty()) return;
+
+	const FString FilePath = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir(), ChessBoard->ChessBoardData->NeuralNetworkFile.FilePath);
+
+	TSharedRef<FChessNeuralNetwork, ESPMode::ThreadSafe> NeuralNetwork = MakeShared<FChessNeuralNetwork, ESPMode::ThreadSafe>();
+	if (!NeuralNetwork->LoadFromFile(FilePath)) return PRINTSTRING(FColor::Red, "Neural network failed to load, AI uses the hand crafted evaluation");
+
+	UE_LOG(LogChess, Log, TEXT("AI neural network loaded from %s (%s)"), *FilePath, FChessNeuralNetwork::GetSimdName());
+
+	AINeuralNetwork = NeuralNetwork;
+}
+
+void AChessGameMode::LoadAIOpeningBook()
+{
+	AIOpeningBook.Reset();
+	AIBookRandom.GenerateNewSeed();
+
+	if (!ChessBoard || !ChessBoard->ChessBoardData || ChessBoard->ChessBoardData->OpeningBookFile.FilePath.IsEmpty()) return;
+
+	const FString BookFile = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir(), ChessBoard->ChessBoardData->OpeningBookFile.FilePath);
+	const FString KeysFile = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir(), ChessBoard->ChessBoardData->OpeningBookKeysFile.FilePath);
+
+	TSharedRef<FChessOpeningBook> OpeningBook = MakeShared<FChessOpeningBook>();
+	if (!OpeningBook->Open(BookFile, KeysFile)) return PRINTSTRING(FColor::Red, "Opening book failed to open, AI searches from the first move");
+
+	UE_LOG(LogChess, Log, TEXT("AI opening book mapped from %s (%lld entries)"), *BookFile, OpeningBook->GetNumEntries());
+
+	AIOpeningBook = OpeningBook;
+}
+
+bool AChessGameMode::TryPlayAIBookMove()
+{
+	if (!AIOpeningBook.IsValid()) return false;
+
+	const FChessPosition& Position = ChessBoard->Position;
+	const int32 GamePly = (Position.GetFullmoveNumber() - 1) * 2 + (Position.GetSideToMove() == EChessColour::Black ? 1 : 0);
+
+	if (GamePly >= GetDefault<UChessAISettings>()->MaxBookDepth) return false;
+
+	const FChessMove BookMove = AIOpeningBook->PickMove(Position, AIBookRandom);
+	if (!BookMove.IsValid()) return false;
+
+	UE_LOG(LogChess, Log, TEXT("AI plays %s from the opening book"), *BookMove.ToString());
+
+	// No search, so no expected reply to ponder on
+	AIPonderMove = FChessMove();
+
+	ApplyAIMove(BookMove);
+	return true;
+}
+
+FChessSearchLimits AChessGameMode::MakeAISearchLimits() const
+{
+	const UChessAISettings* ChessAISettings = GetDefault<UChessAISettings>();
+
+	FChessSearchLimits Limits;
+	Limits.MaxDepth = ChessAISettings->MaxSearchDepth;
+	Limits.MaxTimeSeconds = ChessAISettings->MaxThinkTime;
+	Limits.NumThreads = ChessAISettings->SearchThreads > 0 ? ChessAISettings->SearchThreads : FMath::Max(FPlatformMisc::NumberOfCoresIncludingHyperthreads() - 1, 1);
+
+	if (ChessAISettings->ClockTime > 0.f)
+	{
+		Limits.ClockSeconds = AIClockSeconds;
+		Limits.IncrementSeconds = ChessAISettings->ClockIncrement;
+	}
+
+	return Limits;
+}
+
+void AChessGameMode::StartAIPonder()
+{
+	if (!GetDefault<UChessAISettings>()->bPonder || !AIPonderMove.IsValid()) return;
+	if (!ChessBoard || !ChessPlayerController || !ChessPlayerController->bIsPlayerTurn) return;
+
+	// The reply comes from the last search's principal variation, check it is still legal before playing it on a copy
+	FChessPosition PonderPosition = ChessBoard->Position;
+
+	FChessMoveList LegalMoves;
+	FChessMoveGenerator::GenerateLegalMoves(PonderPosition, LegalMoves);
+
+	bool bIsLegal = false;
+	for (const FChessMove& Move : LegalMoves) bIsLegal |= (Move == AIPonderMove);
+	if (!bIsLegal) return;
+
+	PonderPosition.ApplyMove(AIPonderMove);
+
+	AIPonderKey = PonderPosition.GetKey();
+	bAIPonderHit = false;
+	AIPonderResult.Reset();
+
+	FChessSearchLimits Limits = MakeAISearchLimits();
+	Limits.bPonder = true;
+
+	AIPonderSearch = MakeShared<FChessAsyncSearch, ESPMode::ThreadSafe>(PonderPosition, Limits, ChessBoard->PositionKeyHistory, AITranspositionTable, AINeuralNetwork);
+	AIPonderSearch->Start(
+		FOnChessSearchProgress::CreateUObject(this, &AChessGameMode::OnAIPonderProgress),
+		FOnChessSearchComplete::CreateUObject(this, &AChessGameMode::OnAIPonderComplete));
+
+	UE_LOG(LogChess, Verbose, TEXT("AI ponders on %s"), *AIPonderMove.ToString());
+}
+
+bool AChessGameMode::TryContinueAIPonder()
+{
+	if (!AIPonderSearch.IsValid()) return false;
+
+	TSharedPtr<FChessAsyncSearch, ESPMode::ThreadSafe> PonderSearch = MoveTemp(AIPonderSearch);
+
+	if (ChessBoard->Position.GetKey() != AIPonderKey)
+	{
+		UE_LOG(LogChess, Log, TEXT("AI ponder miss, expected %s"), *AIPonderMove.ToString());
+
+		PonderSearch->Cancel();
+		AIPonderResult.Reset();
+		return false;
+	}
+
+	UE_LOG(LogChess, Log, TEXT("AI ponder hit on %s"), *AIPonderMove.ToString());
+
+	bAIPonderHit = true;
+
+	// The pondering search already finished, its result is this turn's answer
+	if (AIPonderResult.IsValid())
+	{
+		const FChessSearchResult Result = *AIPonderResult;
+		AIPonderResult.Reset();
+
+		OnAISearchComplete(Result);
+		return true;
+	}
+
+	// From here on it completes like any other search, through OnAIPonderComplete
+	AISearch = PonderSearch;
+	AISearch->PonderHit();
+	return true;
+}
+
+void AChessGameMode::OnAIPonderProgress(const FChessSearchResult& Result)
+{
+	if (bAIPonderHit) OnAISearchProgress(Result);
+}
+
+void AChessGameMode::OnAIPonderComplete(const FChessSearchResult& Result)
+{
+	if (bAIPonderHit) return OnAISearchComplete(Result);
+
+	// Ran out of depth before the player moved, kept until their move shows whether the guess was right
+	AIPonderResult = MakeShared<FChessSearchResult>(Result);
+}
+
+void AChessGameMode::PlayAITurn()
+{
+	if (!ChessBoard) return PRINTSTRING(FColor::Red, "ChessBoard is Invalid in GameMode");
+	if (!ChessPlayerController) return PRINTSTRING(FColor::Red, "ChessPlayerController is Invalid in GameMode");
+
+	if (ChessPlayerController->bIsPlayerTurn) return;
+
+	if (AISearch.IsValid() && AISearch->IsRunning()) return PRINTSTRING(FColor::Red, "AI is already thinking");
+
+	AITurnStartTime = FPlatformTime::Seconds();
+
+	// A correct guess carries on from the work done while the player was choosing
+	if (TryContinueAIPonder()) return;
+
+	// Known positions don't need a search
+	if (TryPlayAIBookMove()) return;
+
+	// The search runs on its own copy of the position, so the board can keep animating meanwhile
+	AISearch = MakeShared<FChessAsyncSearch, ESPMode::ThreadSafe>(ChessBoard->Position, MakeAISearchLimits(), ChessBoard->PositionKeyHistory, AITranspositionTable, AINeuralNetwork);
+	AISearch->Start(
+		FOnChessSearchProgress::CreateUObject(this, &AChessGameMode::OnAISearchProgress),
+		FOnChessSearchComplete::CreateUObject(this, &AChessGameMode::OnAISearchComplete));
+}
+
+void AChessGameMode::OnAISearchProgress(const FChessSearchResult& Result)
+{
+	UE_LOG(LogChess, Verbose, TEXT("AI depth %d : %s, score %d, %llu nodes"), Result.Depth, *Result.BestMove.ToString(), Result.Score, Result.Nodes);
+
+	OnAISearchProgressUpdated.Broadcast(Result.Depth, Result.Score);
+}
+
+void AChessGameMode::OnAISearchComplete(const FChessSearchResult& Result)
+{
+	AISearch.Reset();
+
+	if (!Result.BestMove.IsValid()) return PRINTSTRING(FColor::Green, "AI has no legal moves");
+
+	UE_LOG(LogChess, Log, TEXT("AI plays %s : depth %d, score %d, %llu nodes in %.2fs"), *Result.BestMove.ToString(), Result.Depth, Result.Score, Result.Nodes, Result.ElapsedSeconds);
+
+	const FChessMoveOrderingStats& OrderingStats = Result.OrderingStats;
+	UE_LOG(LogChess, Log, TEXT("Move ordering : effective branching factor %.2f, %.1f%% of cutoffs on the first move"),
+		Result.EffectiveBranchingFactor, OrderingStats.BetaCutoffs ? 100.0 * OrderingStats.FirstMoveCutoffs / OrderingStats.BetaCutoffs : 0.0);
+
+	const FChessQuiescenceStats& QuiescenceStats = Result.QuiescenceStats;
+	UE_LOG(LogChess, Log, TEXT("Quiescence : %llu nodes (%.1f%% of the search), %llu stand pat cutoffs, %llu losing captures pruned"),
+		QuiescenceStats.Nodes, Result.Nodes ? 100.0 * QuiescenceStats.Nodes / Result.Nodes : 0.0, QuiescenceStats.StandPatCutoffs, QuiescenceStats.PrunedCaptures);
+
+	if (AITranspositionTable.IsValid())
+	{
+		const FChessTranspositionStats& Stats = Result.TranspositionStats;
+		UE_LOG(LogChess, Log, TEXT("Transposition table : %llu probes, %llu hits (%.1f%%), %llu stores, %llu collisions, hashfull %d"),
+			Stats.Probes, Stats.Hits, Stats.Probes ? 100.0 * Stats.Hits / Stats.Probes : 0.0, Stats.Stores, Stats.Collisions, AITranspositionTable->GetHashfull());
+	}
+
+	// The reply the AI expects, pondered on while the player thinks
+	AIPonderMove = (Result.PrincipalVariation.Num() > 1) ? Result.PrincipalVariation[1] : FChessMove();
+
+	ApplyAIMove(Result.BestMove);
+}
+
+void AChessGameMode::ApplyAIMove(FChessMove Move)
+{
+	if (!ChessBoard) return PRINTSTRING(FColor::Red, "ChessBoard is Invalid in GameMode");
+	if (!ChessPlayerController) return PRINTSTRING(FColor::Red, "ChessPlayerController is Invalid in GameMode");
+
+	if (!ChessBoard->ChessTiles.IsValidIndex(Move.GetFrom()) || !ChessBoard->ChessTiles.IsValidIndex(Move.GetTo())) return PRINTSTRING(FColor::Red, "AI move is off the board in GameMode");
+
+	const UChessAISettings* ChessAISettings = GetDefault<UChessAISettings>();
+	if (ChessAISettings->ClockTime > 0.f)
+	{
+		AIClockSeconds = FMath::Max(AIClockSeconds - (FPlatformTime::Seconds() - AITurnStartTime), 0.0) + ChessAISettings->ClockIncrement;
+		UE_LOG(LogChess, Log, TEXT("AI clock : %.1fs left"), AIClockSeconds);
+	}
+
+	AChessTile* ToTile = ChessBoard->ChessTiles[Move.GetTo()];
+
+	if (!ChessPlayerController->MovePieceToTile(ChessBoard->ChessTiles[Move.GetFrom()], ToTile, false)) return PRINTSTRING(FColor::Red, "AI move is not legal on the board in GameMode");
+
+	// the AI picks its promotion piece as part of the move instead of going through the promotion UI
+	if (Move.IsPromotion() && ToTile->ChessTileInfo.ChessPieceOnTile)
+		ToTile->ChessTileInfo.ChessPieceOnTile->PromotePawn(static_cast<EChessPieceType>(Move.GetPromotionPiece()));
+
+	// After the promotion, so the pondered position has the piece the AI actually chose
+	StartAIPonder();
 }
\ No newline at end of file
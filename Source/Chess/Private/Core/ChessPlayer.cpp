@@ -7,6 +7,9 @@
 
 AChessPlayer::AChessPlayer()
 {
+	// The camera only moves through SwitchPlayerView
+	PrimaryActorTick.bCanEverTick = false;
+
 	// DefaultSceneRootComponent
 	DefaultSceneRootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("DefaultSceneRootComponent"));
 	SetRootComponent(DefaultSceneRootComponent);
@@ -28,11 +31,6 @@ void AChessPlayer::BeginPlay()
 	Super::BeginPlay();
 }
 
-void AChessPlayer::Tick(float DeltaTime)
-{
-	Super::Tick(DeltaTime);
-}
-
 void AChessPlayer::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
 {
 	Super::SetupPlayerInputComponent(PlayerInputComponent);
@@ -82,7 +82,7 @@ void AChessPlayerController::SelectPiece()
 		return;
 	}
 
-	AChessTile* HitTile = Cast<AChessTile>(HitResult.GetActor());
+	AChessTile* HitTile = ChessBoard->GetChessTileFromHit(HitResult);
 	if (!HitTile)
 	{
 		if (SelectedTile)
@@ -116,32 +116,18 @@ void AChessPlayerController::SelectPiece()
 			return PRINTSTRING(FColor::Red, "Tile not Highlighted");
 		}
 
-		if (HitTile->ChessTileInfo.ChessPieceOnTile) // if theres a piece on destination tile...
+		// a friendly piece on the destination tile is never highlighted, but guard against it anyway
+		if (HitTile->ChessTileInfo.ChessPieceOnTile && SelectedTile->ChessTileInfo.ChessPieceOnTile->ChessPieceInfo.bIsWhite == HitTile->ChessTileInfo.ChessPieceOnTile->ChessPieceInfo.bIsWhite)
 		{
-			// and if the piece is a friendly piece...
-			if (SelectedTile->ChessTileInfo.ChessPieceOnTile->ChessPieceInfo.bIsWhite == HitTile->ChessTileInfo.ChessPieceOnTile->ChessPieceInfo.bIsWhite)
-			{
-				return PRINTSTRING(FColor::Red, "Tile is Occupied with a friendly Piece");
-			}
-			else // and if the piece is not a friendly piece...
-			{
-				HitTile->ChessTileInfo.ChessPieceOnTile->CapturePiece(); // capture piece
-			}
+			return PRINTSTRING(FColor::Red, "Tile is Occupied with a friendly Piece");
 		}
 
 		ChessBoard->HightlightValidMovesOnTile(false, SelectedTile->ChessTileInfo);
 
-		SelectedTile->ChessTileInfo.ChessPieceOnTile->MovePiece(HitTile);
-				
-		HitTile->ChessTileInfo.ChessPieceOnTile = SelectedTile->ChessTileInfo.ChessPieceOnTile;
-		HitTile->ChessTileInfo.ChessPieceOnTile->ChessPieceInfo.ChessPiecePositionIndex = HitTile->ChessTileInfo.ChessTilePositionIndex;
-
-		SelectedTile->ChessTileInfo.ChessPieceOnTile = nullptr;
+		AChessTile* FromTile = SelectedTile;
 		SelectedTile = nullptr;
 
-		OnPieceMoved.Broadcast(ChessGameMode->bIsWhiteTurn);
-
-		ChessGameMode->SwitchTurn();
+		MovePieceToTile(FromTile, HitTile);
 	}
 	else // if no tile has been selected already, highlight valid moves for the piece on that tile
 	{
@@ -162,4 +148,59 @@ void AChessPlayerController::SelectPiece()
 		if (ChessBoard->HightlightValidMovesOnTile(true, HitTile->ChessTileInfo))
 			SelectedTile = HitTile;
 	}
+}
+
+bool AChessPlayerController::MovePieceToTile(AChessTile* FromTile, AChessTile* ToTile, bool bShowPromotionUI)
+{
+	if (!FromTile || !ToTile)
+	{
+		PRINTSTRING(FColor::Red, "Invalid Tile in PlayerController > MovePieceToTile()");
+		return false;
+	}
+
+	AChessPiece* MovingPiece = FromTile->ChessTileInfo.ChessPieceOnTile;
+	if (!MovingPiece)
+	{
+		PRINTSTRING(FColor::Red, "ChessPieceOnTile is Invalid in PlayerController > MovePieceToTile()");
+		return false;
+	}
+
+	AChessGameMode* ChessGameMode = Cast<AChessGameMode>(UGameplayStatics::GetGameMode(GetWorld()));
+	if (!ChessGameMode)
+	{
+		PRINTSTRING(FColor::Red, "Game Mode is invalid in PlayerController");
+		return false;
+	}
+
+	AChessBoard* ChessBoard = ChessGameMode->ChessBoard;
+	if (!ChessBoard)
+	{
+		PRINTSTRING(FColor::Red, "ChessBoard is invalid in PlayerController");
+		return false;
+	}
+
+	// Position first, the actors only follow a move it accepted
+	const FChessMove Move = ChessBoard->ApplyMoveToPosition(FromTile->ChessTileInfo.ChessTilePositionIndex, ToTile->ChessTileInfo.ChessTilePositionIndex);
+	if (!Move.IsValid()) return false;
+
+	// Position holds a queen until the promotion UI says otherwise, nothing may search it before then
+	if (Move.IsPromotion() && bShowPromotionUI) ChessGameMode->bIsAwaitingPromotion = true;
+
+	if (AChessPiece* CapturedPiece = ToTile->ChessTileInfo.ChessPieceOnTile) // if theres an opponent piece on destination tile, capture it
+	{
+		CapturedPiece->CapturePiece();
+	}
+
+	MovingPiece->MovePiece(ToTile, bShowPromotionUI);
+
+	ToTile->ChessTileInfo.ChessPieceOnTile = MovingPiece;
+	MovingPiece->ChessPieceInfo.ChessPiecePositionIndex = ToTile->ChessTileInfo.ChessTilePositionIndex;
+
+	FromTile->ChessTileInfo.ChessPieceOnTile = nullptr;
+
+	OnPieceMoved.Broadcast(ChessGameMode->bIsWhiteTurn);
+
+	ChessGameMode->SwitchTurn();
+
+	return true;
 }
\ No newline at end of file
@@ -0,0 +1,17 @@
+// Copyright Kunal Patil (kroxyserver). All Rights Reserved.
+
+#include "Data/ChessAISettings.h"
+
+UChessAISettings::UChessAISettings() :
+	MaxSearchDepth(63),
+	MaxThinkTime(2.f),
+	TranspositionTableSizeMB(64),
+	SearchThreads(0),
+	ClockTime(0.f),
+	ClockIncrement(0.f),
+	bPonder(true),
+	AnalysisLines(3),
+	MaxBookDepth(16)
+{
+	CategoryName = "Game";
+}
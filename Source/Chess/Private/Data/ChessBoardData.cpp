@@ -1,3 +1,26 @@
 // Copyright Kunal Patil (kroxyserver). All Rights Reserved.
 
-#include "Data/ChessBoardData.h"
\ No newline at end of file
+#include "Data/ChessBoardData.h"
+
+#include "Board/ChessPiece.h"
+
+UStaticMesh* UChessBoardData::GetChessPieceMesh(bool bIsWhite, EChessPieceType ChessPieceType) const
+{
+	switch (ChessPieceType)
+	{
+	case EChessPieceType::King:
+		return bIsWhite ? WhiteKing : BlackKing;
+	case EChessPieceType::Queen:
+		return bIsWhite ? WhiteQueen : BlackQueen;
+	case EChessPieceType::Bishop:
+		return bIsWhite ? WhiteBishop : BlackBishop;
+	case EChessPieceType::Knight:
+		return bIsWhite ? WhiteKnight : BlackKnight;
+	case EChessPieceType::Rook:
+		return bIsWhite ? WhiteRook : BlackRook;
+	case EChessPieceType::Pawn:
+		return bIsWhite ? WhitePawn : BlackPawn;
+	default:
+		return nullptr;
+	}
+}
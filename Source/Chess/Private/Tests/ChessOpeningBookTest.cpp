@@ -0,0 +1,48 @@
+// Copyright Kunal Patil (kroxyserver). All Rights Reserved.
+
+#include "AI/ChessOpeningBook.h"
+#include "Board/ChessPosition.h"
+#include "Data/ChessBoardData.h"
+
+#include "Misc/AutomationTest.h"
+#include "Misc/Paths.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// Checks the key file DA_ChessBoardData points the AI at, run from Session Frontend or -ExecCmds="Automation RunTests Chess.AI.OpeningBook"
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FChessOpeningBookTestKeysTest, "Chess.AI.OpeningBook.TestKeys", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FChessOpeningBookTestKeysTest::RunTest(const FString& Parameters)
+{
+	const UChessBoardData* ChessBoardData = LoadObject<UChessBoardData>(nullptr, TEXT("/Game/+Chess/Data/DA_ChessBoardData.DA_ChessBoardData"));
+	if (!TestNotNull(TEXT("DA_ChessBoardData loads"), ChessBoardData)) return false;
+
+	if (ChessBoardData->OpeningBookKeysFile.FilePath.IsEmpty())
+	{
+		AddWarning(TEXT("DA_ChessBoardData has no OpeningBookKeysFile, the opening book is disabled and there is nothing to check"));
+		return true;
+	}
+
+	const FString KeysFile = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir(), ChessBoardData->OpeningBookKeysFile.FilePath);
+
+	// Keeps checking every position after a failure, so one bad table reports all the keys it gets wrong
+	FChessOpeningBook OpeningBook;
+	const bool bLoaded = OpeningBook.LoadRandomKeys(KeysFile);
+
+	if (!bLoaded) AddError(FString::Printf(TEXT("%s doesn't load as a Polyglot key table"), *KeysFile));
+
+	for (const FChessPolyglotTestKey& TestKey : FChessOpeningBook::GetTestKeys())
+	{
+		FChessPosition Position;
+		if (!TestTrue(FString::Printf(TEXT("%s parses"), TestKey.Fen), Position.SetFromFen(TestKey.Fen))) continue;
+
+		if (!bLoaded) continue;
+
+		const uint64 Key = OpeningBook.ComputeKey(Position);
+		if (Key != TestKey.Key) AddError(FString::Printf(TEXT("%s : key %016llx, expected %016llx"), TestKey.Fen, Key, TestKey.Key));
+	}
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,37 @@
+// Copyright Kunal Patil (kroxyserver). All Rights Reserved.
+
+#include "Board/ChessPerft.h"
+#include "Board/ChessPosition.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	// Deep enough to reach castling, en passant and promotions in every suite position while staying well under a second
+	constexpr int32 PerftTestDepth = 3;
+}
+
+// Same suite as ChessPerftCommandlet, run from Session Frontend or -ExecCmds="Automation RunTests Chess.Board.Perft"
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FChessPerftStandardSuiteTest, "Chess.Board.Perft.StandardSuite", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::ProductFilter)
+
+bool FChessPerftStandardSuiteTest::RunTest(const FString& Parameters)
+{
+	for (const FChessPerftCase& Case : FChessPerft::GetStandardSuite())
+	{
+		FChessPosition Position;
+		if (!TestTrue(FString::Printf(TEXT("%s parses"), Case.Name), Position.SetFromFen(Case.Fen))) continue;
+		if (!TestTrue(FString::Printf(TEXT("%s has expected node counts"), Case.Name), Case.ExpectedNodes.Num() > 0)) continue;
+
+		const int32 Depth = FMath::Min(PerftTestDepth, Case.ExpectedNodes.Num());
+		const uint64 Nodes = FChessPerft::Perft(Position, Depth);
+		const uint64 Expected = Case.ExpectedNodes[Depth - 1];
+
+		if (Nodes != Expected) AddError(FString::Printf(TEXT("%s depth %d : %llu nodes, expected %llu"), Case.Name, Depth, Nodes, Expected));
+	}
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,63 @@
+// Copyright Kunal Patil (kroxyserver). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "AI/ChessSearch.h"
+
+#include "Containers/Queue.h"
+#include "Tasks/Task.h"
+
+/**
+ * Open ended multi-PV search of one position for the analysis view, it runs until stopped or out of depth
+ * Only the search thread pushes results and only the game thread pops them, so a single producer queue hands them over without either side waiting on the other
+ */
+class CHESS_API FChessAnalysis : public TSharedFromThis<FChessAnalysis, ESPMode::ThreadSafe>
+{
+public:
+	FChessAnalysis(const FChessPosition& InPosition, const FChessSearchLimits& InLimits, const TArray<uint64>& InGameHistory, TSharedPtr<FChessTranspositionTable, ESPMode::ThreadSafe> InTranspositionTable = nullptr, TSharedPtr<const FChessNeuralNetwork, ESPMode::ThreadSafe> InNeuralNetwork = nullptr);
+
+#pragma region FUNCTIONS
+
+public:
+	void Start();
+
+	// Ends the search, results already queued can still be drained
+	void Stop();
+
+	// Blocks until the worker has returned, only meant for teardown
+	void Wait();
+
+	// Game thread only. Empties the queue and keeps the newest result, false when no iteration completed since the last call
+	bool DrainLatest(FChessSearchResult& OutResult);
+
+	FORCEINLINE bool IsRunning() const { return Task.IsValid() && !Task.IsCompleted(); }
+
+	// The position being analysed, the owner restarts the analysis once the board moves on from it
+	FORCEINLINE const FChessPosition& GetPosition() const { return Position; }
+
+#pragma endregion
+
+#pragma region VARIABLES
+
+private:
+	FChessPosition Position;
+
+	FChessSearchLimits Limits;
+
+	TArray<uint64> GameHistory;
+
+	TSharedPtr<FChessTranspositionTable, ESPMode::ThreadSafe> TranspositionTable;
+
+	TSharedPtr<const FChessNeuralNetwork, ESPMode::ThreadSafe> NeuralNetwork;
+
+	FChessSearch Search;
+
+	UE::Tasks::FTask Task;
+
+	// Every completed iteration, pushed by the search's main thread
+	TQueue<FChessSearchResult, EQueueMode::Spsc> Results;
+
+#pragma endregion
+};
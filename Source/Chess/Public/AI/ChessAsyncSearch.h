@@ -0,0 +1,69 @@
+// Copyright Kunal Patil (kroxyserver). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "AI/ChessSearch.h"
+
+#include "Tasks/Task.h"
+
+DECLARE_DELEGATE_OneParam(FOnChessSearchProgress, const FChessSearchResult&);
+DECLARE_DELEGATE_OneParam(FOnChessSearchComplete, const FChessSearchResult&);
+
+/**
+ * One shot background search on a snapshot of the position
+ * The search runs as a task on the task graph, progress and the final result are marshalled back to the game thread
+ */
+class CHESS_API FChessAsyncSearch : public TSharedFromThis<FChessAsyncSearch, ESPMode::ThreadSafe>
+{
+public:
+	FChessAsyncSearch(const FChessPosition& InPosition, const FChessSearchLimits& InLimits, const TArray<uint64>& InGameHistory, TSharedPtr<FChessTranspositionTable, ESPMode::ThreadSafe> InTranspositionTable = nullptr, TSharedPtr<const FChessNeuralNetwork, ESPMode::ThreadSafe> InNeuralNetwork = nullptr);
+
+#pragma region FUNCTIONS
+
+public:
+	void Start(FOnChessSearchProgress InOnProgress, FOnChessSearchComplete InOnComplete);
+
+	// Ends the search early, OnComplete still fires with the best move found so far
+	void Stop();
+
+	// Ends the search and drops the result, neither delegate fires afterwards
+	void Cancel();
+
+	// The move a pondering search assumed was played, it now runs to its normal time budget and completes as usual
+	void PonderHit();
+
+	// Blocks until the worker has returned, only meant for teardown
+	void Wait();
+
+	FORCEINLINE bool IsRunning() const { return Task.IsValid() && !Task.IsCompleted(); }
+
+#pragma endregion
+
+#pragma region VARIABLES
+
+private:
+	FChessPosition Position;
+
+	FChessSearchLimits Limits;
+
+	TArray<uint64> GameHistory;
+
+	// Held here so the table outlives the worker even if its owner lets go first
+	TSharedPtr<FChessTranspositionTable, ESPMode::ThreadSafe> TranspositionTable;
+
+	TSharedPtr<const FChessNeuralNetwork, ESPMode::ThreadSafe> NeuralNetwork;
+
+	FChessSearch Search;
+
+	UE::Tasks::FTask Task;
+
+	std::atomic<bool> bCancelled { false };
+
+	FOnChessSearchProgress OnProgress;
+
+	FOnChessSearchComplete OnComplete;
+
+#pragma endregion
+};
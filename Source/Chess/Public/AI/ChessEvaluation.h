@@ -0,0 +1,25 @@
+// Copyright Kunal Patil (kroxyserver). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Board/ChessMove.h"
+
+class FChessPosition;
+
+// Tapered evaluation : material and piece-square tables come incrementally from the position,
+// mobility, king safety and pawn structure are computed per call, then middlegame and endgame scores are blended by phase
+class CHESS_API FChessEvaluation
+{
+public:
+	// Centipawn values indexed by EChessPiece::Type, the king is never traded so it is worth nothing
+	static constexpr int32 PieceValues[EChessPiece::Num] = { 0, 900, 330, 320, 500, 100 };
+
+	// Score in centipawns from the side to move's point of view
+	static int32 Evaluate(const FChessPosition& Position);
+
+	// Static exchange evaluation : material the side to move nets from Move once every capture on the target square is played out,
+	// each side always recapturing with its least valuable attacker and free to stop when continuing would lose material
+	static int32 StaticExchange(const FChessPosition& Position, FChessMove Move);
+};
@@ -0,0 +1,110 @@
+// Copyright Kunal Patil (kroxyserver). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Board/ChessMove.h"
+
+class FChessPosition;
+
+namespace EChessMovePickerStage
+{
+	enum Type : uint8
+	{
+		HashMove,
+		GenerateCaptures,
+		GoodCaptures,
+		FirstKiller,
+		SecondKiller,
+		CounterMove,
+		GenerateQuiets,
+		Quiets,
+		BadCaptures,
+		Done
+	};
+}
+
+// Butterfly history : how well a quiet move From -> To has done for each side, kept in step with the current search by decaying towards zero
+struct FChessHistory
+{
+	static constexpr int32 MaxScore = 16384;
+
+	int32 Scores[EChessColour::Num][64][64];
+
+	FORCEINLINE void Clear() { FMemory::Memzero(Scores); }
+
+	FORCEINLINE int32 Get(EChessColour::Type Colour, FChessMove Move) const { return Scores[Colour][Move.GetFrom()][Move.GetTo()]; }
+
+	// Bonus is negative for moves that were tried and failed, the decay keeps every score within MaxScore
+	FORCEINLINE void Update(EChessColour::Type Colour, FChessMove Move, int32 Bonus)
+	{
+		int32& Score = Scores[Colour][Move.GetFrom()][Move.GetTo()];
+		Score += Bonus - Score * FMath::Abs(Bonus) / MaxScore;
+	}
+};
+
+namespace ChessMoveOrdering
+{
+	// Most valuable victim first, cheapest attacker breaking ties, promotions count as winning the promoted piece
+	int32 GetCaptureScore(const FChessPosition& Position, FChessMove Move);
+}
+
+/**
+ * Hands out the moves of a position one at a time, best guess first, only generating and sorting a stage once the earlier ones are used up
+ * Order : hash move, captures that don't lose material by SEE, killers, countermove, quiets by history, losing captures
+ * A cutoff on the hash move or a good capture means the quiet moves are never generated at all
+ */
+class CHESS_API FChessMovePicker
+{
+public:
+	// Killers point at the two killer slots of this ply, all of HashMove, Killers and CounterMove may be invalid or illegal here
+	FChessMovePicker(FChessPosition& InPosition, FChessMove InHashMove, const FChessMove* InKillers, FChessMove InCounterMove, const FChessHistory& InHistory);
+
+	// Next legal move, an invalid move once every move has been handed out
+	FChessMove Next();
+
+	FORCEINLINE EChessMovePickerStage::Type GetStage() const { return Stage; }
+
+#pragma region FUNCTIONS
+
+private:
+	// Selection sort one move at a time, a cutoff usually comes long before the list is exhausted
+	FChessMove PickBest();
+
+	// For moves that didn't come from the generator
+	bool IsUsable(FChessMove Move) const;
+
+	// Already handed out by one of the single move stages
+	bool IsSpecialMove(FChessMove Move) const;
+
+#pragma endregion
+
+#pragma region VARIABLES
+
+private:
+	FChessPosition& Position;
+
+	const FChessHistory& History;
+
+	FChessMove HashMove;
+
+	FChessMove Killers[2];
+
+	FChessMove CounterMove;
+
+	EChessMovePickerStage::Type Stage = EChessMovePickerStage::HashMove;
+
+	FChessMoveList Moves;
+
+	int32 Scores[FChessMoveList::MaxMoves];
+
+	int32 Current = 0;
+
+	// Captures SEE says lose material, tried after every quiet move
+	FChessMoveList BadCaptures;
+
+	int32 CurrentBadCapture = 0;
+
+#pragma endregion
+};
@@ -0,0 +1,81 @@
+// Copyright Kunal Patil (kroxyserver). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Board/ChessMove.h"
+
+class FChessPosition;
+
+namespace ChessNeuralNetwork
+{
+	// One input per (own / enemy) x piece x square, seen from each side's perspective
+	constexpr int32 NumFeatures = 768;
+
+	constexpr int32 HiddenSize = 256;
+
+	// Quantisation of the accumulator and output weights, and centipawns per unit of network output
+	constexpr int32 QA = 255;
+	constexpr int32 QB = 64;
+	constexpr int32 OutputScale = 400;
+}
+
+// First layer output for both perspectives, copied and updated once per move instead of recomputed from every piece
+struct alignas(64) FChessAccumulator
+{
+	int16 Values[EChessColour::Num][ChessNeuralNetwork::HiddenSize];
+};
+
+/**
+ * Efficiently updatable network : 768 -> 256 x 2 -> 1 with squared clipped ReLU
+ * Weights are raw little endian int16 in the layout the bullet trainer writes for this architecture :
+ * feature weights [768][256], feature biases [256], output weights [512] (side to move half first), output bias, padded to 64 bytes
+ * Features are ordered own / enemy, then pawn, knight, bishop, rook, queen, king, then square with a1 = 0, ranks flipped for black
+ */
+class CHESS_API FChessNeuralNetwork
+{
+public:
+	FChessNeuralNetwork();
+
+#pragma region FUNCTIONS
+
+public:
+	bool LoadFromFile(const FString& FilePath);
+
+	bool LoadFromMemory(const uint8* Data, int64 Size);
+
+	// Random weights of realistic magnitude, only meaningful for measuring throughput
+	void InitializeRandom(uint32 Seed);
+
+	FORCEINLINE bool IsLoaded() const { return bIsLoaded; }
+
+	// Rebuilds both perspectives from every piece on the board
+	void RefreshAccumulator(const FChessPosition& Position, FChessAccumulator& OutAccumulator) const;
+
+	// Child = Parent with the features Move adds and removes, Position is the one Move is about to be played in
+	void UpdateAccumulator(const FChessAccumulator& Parent, FChessAccumulator& OutChild, const FChessPosition& Position, FChessMove Move) const;
+
+	// Centipawns from the side to move's point of view
+	int32 Evaluate(const FChessAccumulator& Accumulator, EChessColour::Type SideToMove) const;
+
+	// Name of the vector instruction set the inference path was compiled for
+	static const TCHAR* GetSimdName();
+
+#pragma endregion
+
+#pragma region VARIABLES
+
+private:
+	TArray<int16> FeatureWeights;
+
+	TArray<int16> FeatureBiases;
+
+	TArray<int16> OutputWeights;
+
+	int16 OutputBias;
+
+	bool bIsLoaded;
+
+#pragma endregion
+};
@@ -0,0 +1,113 @@
+// Copyright Kunal Patil (kroxyserver). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Board/ChessMove.h"
+
+class FChessPosition;
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+namespace ChessPolyglot
+{
+	// 12 x 64 piece-square keys, 4 castling keys, 8 en passant file keys and the side to move key
+	constexpr int32 NumRandomKeys = 781;
+
+	constexpr int32 CastlingKeyOffset = 768;
+
+	constexpr int32 EnPassantKeyOffset = 772;
+
+	constexpr int32 TurnKeyOffset = 780;
+
+	// Key of the standard starting position in the Polyglot specification, a key table that doesn't reproduce it is the wrong one
+	constexpr uint64 StartingPositionKey = 0x463B96181691FC9CULL;
+
+	// Key u64, move u16, weight u16, learn u32, all big endian
+	constexpr int32 EntrySize = 16;
+}
+
+// One of the positions the Polyglot specification publishes the key of
+struct FChessPolyglotTestKey
+{
+	const TCHAR* Fen;
+
+	uint64 Key;
+};
+
+struct FChessBookMove
+{
+	FChessMove Move;
+
+	// Relative frequency the book author gave the move, higher is played more often
+	uint16 Weight = 0;
+};
+
+/**
+ * Read only Polyglot opening book. The .bin file is memory mapped and binary searched in place, never loaded onto the heap,
+ * so only the pages around the looked up keys are ever read from disk
+ */
+class CHESS_API FChessOpeningBook
+{
+public:
+	FChessOpeningBook();
+
+	~FChessOpeningBook();
+
+#pragma region FUNCTIONS
+
+public:
+	// KeysFile holds Polyglot's 781 Random64 constants as big endian uint64, see LoadRandomKeys
+	bool Open(const FString& BookFile, const FString& KeysFile);
+
+	// Fails unless the table reproduces every one of the specification's test keys
+	bool LoadRandomKeys(const FString& KeysFile);
+
+	void Close();
+
+	FORCEINLINE bool IsOpen() const { return Entries != nullptr; }
+
+	FORCEINLINE int64 GetNumEntries() const { return NumEntries; }
+
+	// Polyglot hash of Position, unrelated to FChessPosition::GetKey. 0 until the Random64 table is loaded
+	uint64 ComputeKey(const FChessPosition& Position) const;
+
+	// Every book move for Position that is legal in it, in file order
+	void GetMoves(const FChessPosition& Position, TArray<FChessBookMove>& OutMoves) const;
+
+	// Picks a book move with probability proportional to its weight, invalid when Position is out of book
+	FChessMove PickMove(const FChessPosition& Position, FRandomStream& Random) const;
+
+	// Every test position the specification lists, between them they cover pawns, kings, castling, en passant and the side to move
+	static TConstArrayView<FChessPolyglotTestKey> GetTestKeys();
+
+private:
+	// Index of the first entry with Key, NumEntries when there is none
+	int64 FindFirstEntry(uint64 Key) const;
+
+	FORCEINLINE uint64 GetEntryKey(int64 Index) const { return ReadBigEndian(Entries + Index * ChessPolyglot::EntrySize, 8); }
+
+	// Turns a Polyglot move into the legal move it stands for, invalid when nothing legal matches
+	static FChessMove DecodeMove(uint16 BookMove, const FChessPosition& Position);
+
+	static uint64 ReadBigEndian(const uint8* Data, int32 NumBytes);
+
+#pragma endregion
+
+#pragma region VARIABLES
+
+private:
+	// Polyglot's Random64 table, kept in a data file rather than compiled in
+	TArray<uint64> RandomKeys;
+
+	TUniquePtr<IMappedFileHandle> MappedFile;
+
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+
+	const uint8* Entries = nullptr;
+
+	int64 NumEntries = 0;
+
+#pragma endregion
+};
@@ -0,0 +1,253 @@
+// Copyright Kunal Patil (kroxyserver). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "AI/ChessMovePicker.h"
+#include "AI/ChessNeuralNetwork.h"
+#include "AI/ChessTimeManager.h"
+#include "AI/ChessTranspositionTable.h"
+#include "Board/ChessMove.h"
+#include "Board/ChessPosition.h"
+
+#include <atomic>
+
+namespace ChessSearch
+{
+	constexpr int32 MaxPly = 64;
+
+	constexpr int32 MaxThreads = 256;
+
+	constexpr int32 Infinity = 32000;
+
+	// Mate in N plies scores MateScore - N, so shorter mates are preferred
+	constexpr int32 MateScore = 31000;
+
+	constexpr int32 MateThreshold = MateScore - MaxPly;
+
+	FORCEINLINE bool IsMateScore(int32 Score) { return FMath::Abs(Score) >= MateThreshold; }
+}
+
+struct FChessSearchLimits
+{
+	// Iterative deepening stops after this depth
+	int32 MaxDepth = ChessSearch::MaxPly;
+
+	// Wall clock budget in seconds, 0 means no limit. With a clock as well it caps the clock's budget
+	double MaxTimeSeconds = 0.0;
+
+	// Time left on the side to move's clock, 0 plays without one and only MaxTimeSeconds applies
+	double ClockSeconds = 0.0;
+
+	double IncrementSeconds = 0.0;
+
+	// Moves until the next time control, 0 for sudden death
+	int32 MovesToGo = 0;
+
+	// Searches with no time limit until PonderHit, the budget then counts from the hit
+	bool bPonder = false;
+
+	// Threads searching in parallel, extra threads need a transposition table to share work through
+	int32 NumThreads = 1;
+
+	// Best lines reported per iteration, each one searched with the root moves of the lines before it excluded
+	int32 MultiPV = 1;
+};
+
+// Counted by each search thread on its own and summed afterwards, like FChessTranspositionStats
+struct FChessQuiescenceStats
+{
+	// Nodes visited past the horizon, already included in FChessSearchResult::Nodes
+	uint64 Nodes = 0;
+
+	// Nodes where the static evaluation alone was already good enough to cut off
+	uint64 StandPatCutoffs = 0;
+
+	// Captures skipped because the static exchange evaluation says they lose material
+	uint64 PrunedCaptures = 0;
+
+	FChessQuiescenceStats& operator+=(const FChessQuiescenceStats& Other)
+	{
+		Nodes += Other.Nodes;
+		StandPatCutoffs += Other.StandPatCutoffs;
+		PrunedCaptures += Other.PrunedCaptures;
+		return *this;
+	}
+};
+
+struct FChessMoveOrderingStats
+{
+	uint64 BetaCutoffs = 0;
+
+	// Cutoffs on the first move tried, the share of these is the usual measure of how good the ordering is
+	uint64 FirstMoveCutoffs = 0;
+
+	FChessMoveOrderingStats& operator+=(const FChessMoveOrderingStats& Other)
+	{
+		BetaCutoffs += Other.BetaCutoffs;
+		FirstMoveCutoffs += Other.FirstMoveCutoffs;
+		return *this;
+	}
+};
+
+struct FChessSearchLine
+{
+	// Centipawns from the side to move's point of view
+	int32 Score = 0;
+
+	int32 Depth = 0;
+
+	TArray<FChessMove> PrincipalVariation;
+};
+
+struct FChessSearchResult
+{
+	FChessMove BestMove;
+
+	// Centipawns from the side to move's point of view
+	int32 Score = 0;
+
+	// Last fully searched depth
+	int32 Depth = 0;
+
+	uint64 Nodes = 0;
+
+	double ElapsedSeconds = 0.0;
+
+	// Nodes of the last completed iteration over nodes of the one before, 0 until two iterations have completed
+	double EffectiveBranchingFactor = 0.0;
+
+	TArray<FChessMove> PrincipalVariation;
+
+	// Best first, as many as FChessSearchLimits::MultiPV asked for and the position has legal moves. Lines[0] matches the fields above
+	TArray<FChessSearchLine> Lines;
+
+	FChessTranspositionStats TranspositionStats;
+
+	FChessQuiescenceStats QuiescenceStats;
+
+	FChessMoveOrderingStats OrderingStats;
+};
+
+// Iterative deepening negamax with alpha-beta pruning, works on its own copy of the position
+// With more than one thread, helper searches run on the task graph and share the transposition table (Lazy SMP)
+class CHESS_API FChessSearch
+{
+public:
+	// GameHistory holds the keys of the positions played so far, so the search can see repetitions
+	FChessSearchResult Search(const FChessPosition& RootPosition, const FChessSearchLimits& Limits, const TArray<uint64>& GameHistory = TArray<uint64>());
+
+	// Safe to call from any thread, the search returns its last completed iteration shortly after
+	FORCEINLINE void RequestStop() { bStopRequested.store(true, std::memory_order_relaxed); }
+
+	// Safe to call from any thread, the move pondered on was played so the search carries on under the normal time limits
+	FORCEINLINE void PonderHit() { bPonderHitRequested.store(true, std::memory_order_relaxed); }
+
+	// Optional, the table isn't owned and may be shared with other searches
+	FORCEINLINE void SetTranspositionTable(FChessTranspositionTable* InTranspositionTable) { TranspositionTable = InTranspositionTable; }
+
+	// Optional, leaves are scored by the network instead of FChessEvaluation when one is loaded
+	FORCEINLINE void SetNeuralNetwork(const FChessNeuralNetwork* InNeuralNetwork) { NeuralNetwork = (InNeuralNetwork && InNeuralNetwork->IsLoaded()) ? InNeuralNetwork : nullptr; }
+
+	// Called from the searching thread after every completed iteration
+	TFunction<void(const FChessSearchResult&)> OnIterationComplete;
+
+#pragma region FUNCTIONS
+
+private:
+	FChessSearchResult IterativeDeepening(const FChessPosition& RootPosition, const FChessSearchLimits& Limits, const TArray<uint64>& GameHistory);
+
+	int32 Negamax(int32 Depth, int32 Ply, int32 Alpha, int32 Beta);
+
+	// Captures and promotions only past the horizon, so leaves are never scored in the middle of an exchange
+	int32 Quiescence(int32 Ply, int32 Alpha, int32 Beta);
+
+	int32 Evaluate(int32 Ply) const;
+
+	// The previous iteration's principal variation move while still on that line, invalid otherwise
+	FChessMove GetPrincipalVariationMove(int32 Ply);
+
+	// Killers, countermove and history after a quiet move caused a beta cutoff
+	void UpdateQuietMoveOrdering(FChessMove Move, const FChessMoveList& QuietsSearched, FChessMove PreviousMove, int32 Depth, int32 Ply);
+
+	void UpdatePrincipalVariation(FChessMove Move, int32 Ply);
+
+	bool ShouldStop();
+
+	// Starts the time budget once a ponder hit arrives, only the searching thread calls this
+	void CheckPonderHit();
+
+	// Any earlier occurrence counts, repeating once is enough to hold a draw
+	bool IsRepetition(int32 Ply) const;
+
+#pragma endregion
+
+#pragma region VARIABLES
+
+private:
+	FChessPosition Position;
+
+	// Triangular PV table, row Ply holds the best line found from that ply
+	FChessMove PrincipalVariation[ChessSearch::MaxPly][ChessSearch::MaxPly];
+
+	int32 PrincipalVariationLength[ChessSearch::MaxPly];
+
+	TArray<FChessMove> PreviousPrincipalVariation;
+
+	// Root moves already taken by earlier lines of this iteration, skipped when searching the next line
+	FChessMoveList ExcludedRootMoves;
+
+	// Game history followed by the key at every ply of the current line
+	TArray<uint64> KeyHistory;
+
+	int32 RootHistoryIndex = 0;
+
+	bool bFollowPrincipalVariation = false;
+
+	// Move played at every ply of the current line
+	FChessMove MoveStack[ChessSearch::MaxPly];
+
+	// Two quiet moves per ply that recently caused a cutoff at that ply, likely to cut off in sibling positions too
+	FChessMove Killers[ChessSearch::MaxPly][2];
+
+	// Quiet reply that last refuted each move, indexed by that move's From and To
+	FChessMove CounterMoves[64][64];
+
+	FChessHistory History;
+
+	FChessTranspositionTable* TranspositionTable = nullptr;
+
+	const FChessNeuralNetwork* NeuralNetwork = nullptr;
+
+	// Network accumulator for every ply of the current line, only used with a network
+	TArray<FChessAccumulator> Accumulators;
+
+	TArray<TUniquePtr<FChessSearch>> Helpers;
+
+	// 0 for the main search
+	int32 HelperIndex = 0;
+
+	FChessTranspositionStats TranspositionStats;
+
+	FChessQuiescenceStats QuiescenceStats;
+
+	FChessMoveOrderingStats OrderingStats;
+
+	uint64 Nodes = 0;
+
+	double StartTime = 0.0;
+
+	// Only the main search watches the clock, it stops the helpers itself
+	FChessTimeManager TimeManager;
+
+	bool bPondering = false;
+
+	bool bStopped = false;
+
+	std::atomic<bool> bStopRequested { false };
+
+	std::atomic<bool> bPonderHitRequested { false };
+
+#pragma endregion
+};
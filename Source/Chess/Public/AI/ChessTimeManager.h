@@ -0,0 +1,54 @@
+// Copyright Kunal Patil (kroxyserver). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "HAL/PlatformTime.h"
+
+class FChessPosition;
+
+struct FChessSearchLimits;
+
+/**
+ * Turns the clock into a budget for one move : an optimum the search aims for and a maximum it never goes past
+ * The optimum is only checked between iterations, where it shrinks while the best move holds and grows when the score drops
+ */
+class CHESS_API FChessTimeManager
+{
+#pragma region FUNCTIONS
+
+public:
+	// Works out both budgets from the limits, without a clock only MaxTimeSeconds applies and there is no optimum
+	void Initialize(const FChessSearchLimits& Limits, const FChessPosition& RootPosition);
+
+	// Starts the clock, called again on a ponder hit so the budget counts from when the move was really due
+	void Start();
+
+	FORCEINLINE double GetElapsedSeconds() const { return FPlatformTime::Seconds() - StartTime; }
+
+	// Hard limit, checked from inside the search
+	FORCEINLINE bool IsOutOfTime() const { return MaximumSeconds > 0.0 && GetElapsedSeconds() >= MaximumSeconds; }
+
+	// Checked after every completed iteration. BestMoveStability counts the iterations in a row that kept the same best move, ScoreDrop is how much worse this iteration scored than the last
+	bool ShouldStopIteration(int32 BestMoveStability, int32 ScoreDrop) const;
+
+	FORCEINLINE double GetOptimumSeconds() const { return OptimumSeconds; }
+
+	FORCEINLINE double GetMaximumSeconds() const { return MaximumSeconds; }
+
+#pragma endregion
+
+#pragma region VARIABLES
+
+private:
+	double StartTime = 0.0;
+
+	// 0 when there is no clock to budget from
+	double OptimumSeconds = 0.0;
+
+	// 0 means no limit
+	double MaximumSeconds = 0.0;
+
+#pragma endregion
+};
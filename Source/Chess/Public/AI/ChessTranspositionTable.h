@@ -0,0 +1,113 @@
+// Copyright Kunal Patil (kroxyserver). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Board/ChessMove.h"
+
+#include <atomic>
+
+namespace EChessBound
+{
+	enum Type : uint8
+	{
+		None,
+		Exact,
+		Lower,	// fail high, the real score is at least Score
+		Upper	// fail low, the real score is at most Score
+	};
+}
+
+struct FChessTranspositionEntry
+{
+	FChessMove BestMove;
+
+	int32 Score = 0;
+
+	int32 Depth = 0;
+
+	EChessBound::Type Bound = EChessBound::None;
+};
+
+// Counted by each search thread on its own and summed afterwards, so the table itself stays free of shared counters
+struct FChessTranspositionStats
+{
+	uint64 Probes = 0;
+
+	uint64 Hits = 0;
+
+	uint64 Stores = 0;
+
+	// Stores that evicted an entry belonging to a different position
+	uint64 Collisions = 0;
+
+	FChessTranspositionStats& operator+=(const FChessTranspositionStats& Other)
+	{
+		Probes += Other.Probes;
+		Hits += Other.Hits;
+		Stores += Other.Stores;
+		Collisions += Other.Collisions;
+		return *this;
+	}
+};
+
+/**
+ * Fixed size hash table shared by every search thread without locks
+ * Each slot stores Key ^ Data next to Data, a slot torn by two threads writing at once fails the key check and reads as a miss
+ */
+class CHESS_API FChessTranspositionTable
+{
+public:
+	explicit FChessTranspositionTable(int32 SizeInMegabytes);
+
+#pragma region FUNCTIONS
+
+public:
+	void Resize(int32 SizeInMegabytes);
+
+	void Clear();
+
+	// Ages every entry by one search so old results are replaced first
+	FORCEINLINE void NewSearch() { Generation.store(static_cast<uint8>((Generation.load(std::memory_order_relaxed) + 1) & GenerationMask), std::memory_order_relaxed); }
+
+	// Ply converts mate scores between distance from the root and distance from this node
+	bool Probe(uint64 Key, int32 Ply, FChessTranspositionEntry& OutEntry, FChessTranspositionStats& Stats) const;
+
+	void Store(uint64 Key, int32 Ply, FChessMove BestMove, int32 Score, int32 Depth, EChessBound::Type Bound, FChessTranspositionStats& Stats);
+
+	// Permille of sampled slots written during the current search, the usual UCI hashfull figure
+	int32 GetHashfull() const;
+
+	FORCEINLINE uint64 GetSizeInBytes() const { return static_cast<uint64>(NumClusters) * sizeof(FCluster); }
+
+#pragma endregion
+
+#pragma region VARIABLES
+
+private:
+	static constexpr uint8 GenerationMask = 0x3F;
+
+	static constexpr int32 EntriesPerCluster = 4;
+
+	struct FSlot
+	{
+		std::atomic<uint64> KeyXorData { 0 };
+
+		std::atomic<uint64> Data { 0 };
+	};
+
+	// One cache line per probe
+	struct alignas(64) FCluster
+	{
+		FSlot Slots[EntriesPerCluster];
+	};
+
+	TUniquePtr<FCluster[]> Clusters;
+
+	uint64 NumClusters = 0;
+
+	std::atomic<uint8> Generation { 0 };
+
+#pragma endregion
+};
@@ -0,0 +1,63 @@
+// Copyright Kunal Patil (kroxyserver). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Board/ChessMove.h"
+
+class FChessPosition;
+
+// Squares attacked by each colour, kept in step with a position by only recomputing the pieces a change touches
+// Sliders see through the opponent king, so squares behind it along the ray count as attacked too
+class CHESS_API FChessAttackMap
+{
+public:
+	FChessAttackMap();
+
+#pragma region FUNCTIONS
+
+public:
+	// Recomputes every piece from scratch
+	void Reset(const FChessPosition& Position);
+
+	// Diffs Position against the last one seen and recomputes pieces on changed squares plus sliders whose rays cross them
+	void Update(const FChessPosition& Position);
+
+	// Includes squares holding Colour's own pieces, i.e. defended squares
+	FORCEINLINE uint64 GetAttacks(EChessColour::Type Colour) const { return ColourAttacks[Colour]; }
+
+	FORCEINLINE uint64 GetPieceAttacks(int32 Square) const { return SquareAttacks[Square]; }
+
+	FORCEINLINE bool IsSquareAttacked(int32 Square, EChessColour::Type ByColour) const { return (ColourAttacks[ByColour] >> Square) & 1; }
+
+	// Squares whose occupant changed in the last Update
+	FORCEINLINE uint64 GetChangedSquares() const { return ChangedSquares; }
+
+	// Pieces recomputed by the last Update, a full Reset counts every piece
+	FORCEINLINE int32 GetNumPiecesUpdated() const { return NumPiecesUpdated; }
+
+private:
+	uint64 ComputePieceAttacks(const FChessPosition& Position, int32 Square) const;
+
+	void RebuildColourAttacks();
+
+#pragma endregion
+
+#pragma region VARIABLES
+
+private:
+	// Attacks of the piece standing on each square, 0 for empty squares
+	uint64 SquareAttacks[64];
+
+	uint64 ColourAttacks[EChessColour::Num];
+
+	// Piece placement the attacks were computed for
+	uint64 PieceBitboards[EChessColour::Num][EChessPiece::Num];
+
+	uint64 ChangedSquares;
+
+	int32 NumPiecesUpdated;
+
+#pragma endregion
+};
@@ -0,0 +1,124 @@
+// Copyright Kunal Patil (kroxyserver). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// PEXT gives the slider table index in one instruction, builds without BMI2 use magic multiplication instead
+#ifndef CHESS_USE_PEXT
+	#if PLATFORM_CPU_X86_FAMILY && defined(__BMI2__)
+		#define CHESS_USE_PEXT 1
+	#else
+		#define CHESS_USE_PEXT 0
+	#endif
+#endif
+
+#if CHESS_USE_PEXT
+	#include <immintrin.h>
+#endif
+
+// Squares are indexed the same way as ChessTiles : Rank * 8 + File, so index 0 is the white queen side rook tile (a1) and 63 is h8
+namespace ChessBitboard
+{
+	constexpr uint64 Empty = 0ULL;
+	constexpr uint64 Full = ~0ULL;
+
+	constexpr uint64 FileA = 0x0101010101010101ULL;
+	constexpr uint64 FileB = FileA << 1;
+	constexpr uint64 FileG = FileA << 6;
+	constexpr uint64 FileH = FileA << 7;
+
+	constexpr uint64 Rank1 = 0xFFULL;
+	constexpr uint64 Rank2 = Rank1 << (8 * 1);
+	constexpr uint64 Rank3 = Rank1 << (8 * 2);
+	constexpr uint64 Rank4 = Rank1 << (8 * 3);
+	constexpr uint64 Rank5 = Rank1 << (8 * 4);
+	constexpr uint64 Rank6 = Rank1 << (8 * 5);
+	constexpr uint64 Rank7 = Rank1 << (8 * 6);
+	constexpr uint64 Rank8 = Rank1 << (8 * 7);
+
+	FORCEINLINE constexpr uint64 SquareMask(int32 Square) { return 1ULL << Square; }
+
+	FORCEINLINE constexpr int32 GetRank(int32 Square) { return Square >> 3; }
+
+	FORCEINLINE constexpr int32 GetFile(int32 Square) { return Square & 7; }
+
+	FORCEINLINE constexpr int32 MakeSquare(int32 Rank, int32 File) { return Rank * 8 + File; }
+
+	FORCEINLINE int32 CountBits(uint64 Bitboard) { return static_cast<int32>(FMath::CountBits(Bitboard)); }
+
+	FORCEINLINE int32 GetLeastSignificantSquare(uint64 Bitboard) { return static_cast<int32>(FMath::CountTrailingZeros64(Bitboard)); }
+
+	FORCEINLINE int32 PopLeastSignificantSquare(uint64& Bitboard)
+	{
+		const int32 Square = GetLeastSignificantSquare(Bitboard);
+		Bitboard &= Bitboard - 1;
+		return Square;
+	}
+
+	FORCEINLINE bool HasMoreThanOne(uint64 Bitboard) { return (Bitboard & (Bitboard - 1)) != 0; }
+
+	FORCEINLINE constexpr uint64 ShiftNorth(uint64 Bitboard) { return Bitboard << 8; }
+	FORCEINLINE constexpr uint64 ShiftSouth(uint64 Bitboard) { return Bitboard >> 8; }
+	FORCEINLINE constexpr uint64 ShiftEast(uint64 Bitboard) { return (Bitboard & ~FileH) << 1; }
+	FORCEINLINE constexpr uint64 ShiftWest(uint64 Bitboard) { return (Bitboard & ~FileA) >> 1; }
+
+	struct FSliderMagic
+	{
+		uint64 Mask = 0;
+		uint64 Magic = 0;
+		uint64* Attacks = nullptr;
+		uint32 Shift = 0;
+
+		FORCEINLINE uint32 GetIndex(uint64 Occupied) const
+		{
+#if CHESS_USE_PEXT
+			return static_cast<uint32>(_pext_u64(Occupied, Mask));
+#else
+			return static_cast<uint32>(((Occupied & Mask) * Magic) >> Shift);
+#endif
+		}
+	};
+
+	namespace Tables
+	{
+		extern CHESS_API uint64 KnightAttacks[64];
+		extern CHESS_API uint64 KingAttacks[64];
+		extern CHESS_API uint64 PawnAttacks[2][64];
+		extern CHESS_API FSliderMagic RookMagics[64];
+		extern CHESS_API FSliderMagic BishopMagics[64];
+		extern CHESS_API uint64 Between[64][64];
+		extern CHESS_API uint64 Line[64][64];
+	}
+
+	// Builds the leaper and slider attack tables, called once from FChessModule::StartupModule
+	CHESS_API void InitializeAttackTables();
+
+	// Leaper attacks
+	FORCEINLINE uint64 GetKnightAttacks(int32 Square) { return Tables::KnightAttacks[Square]; }
+
+	FORCEINLINE uint64 GetKingAttacks(int32 Square) { return Tables::KingAttacks[Square]; }
+
+	FORCEINLINE uint64 GetPawnAttacks(bool bIsWhite, int32 Square) { return Tables::PawnAttacks[bIsWhite ? 0 : 1][Square]; }
+
+	// Slider attacks, Occupied blocks the ray but the blocking square itself is included
+	FORCEINLINE uint64 GetRookAttacks(int32 Square, uint64 Occupied)
+	{
+		const FSliderMagic& Magic = Tables::RookMagics[Square];
+		return Magic.Attacks[Magic.GetIndex(Occupied)];
+	}
+
+	FORCEINLINE uint64 GetBishopAttacks(int32 Square, uint64 Occupied)
+	{
+		const FSliderMagic& Magic = Tables::BishopMagics[Square];
+		return Magic.Attacks[Magic.GetIndex(Occupied)];
+	}
+
+	FORCEINLINE uint64 GetQueenAttacks(int32 Square, uint64 Occupied) { return GetRookAttacks(Square, Occupied) | GetBishopAttacks(Square, Occupied); }
+
+	// Squares strictly between two aligned squares, empty if they don't share a rank, file or diagonal
+	FORCEINLINE uint64 GetBetween(int32 SquareA, int32 SquareB) { return Tables::Between[SquareA][SquareB]; }
+
+	// Whole board line through two aligned squares, empty if they don't share a rank, file or diagonal
+	FORCEINLINE uint64 GetLine(int32 SquareA, int32 SquareB) { return Tables::Line[SquareA][SquareB]; }
+}
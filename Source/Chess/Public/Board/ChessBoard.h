@@ -4,6 +4,9 @@
 
 #include "CoreMinimal.h"
 
+#include "Board/ChessAttackMap.h"
+#include "Board/ChessPosition.h"
+
 #include "GameFramework/Actor.h"
 
 #include "ChessBoard.generated.h"
@@ -11,9 +14,16 @@
 class AChessPiece;
 class AChessTile;
 class UChessBoardData;
+class UInstancedStaticMeshComponent;
+class UMaterialInterface;
 struct FChessPieceInfo;
 struct FChessTileInfo;
 
+enum class EChessPieceType : uint8;
+
+// Position changed by a move, capture or promotion
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnBoardPositionChanged);
+
 UCLASS()
 class CHESS_API AChessBoard : public AActor
 {
@@ -22,14 +32,21 @@ class CHESS_API AChessBoard : public AActor
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "+Chess|Board", meta = (AllowPrivateAccess = "true"))
 	USceneComponent* DefaultSceneRootComponent = nullptr;
 
+	// One draw per tile look when bUseInstancedTiles is set, white, black then highlighted. Instance i of each is tile i, at zero scale where the tile looks different
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "+Chess|Board", meta = (AllowPrivateAccess = "true"))
+	TArray<UInstancedStaticMeshComponent*> ChessTileInstances;
+
+	// One draw per piece colour and type when bUseInstancedPieces is set, laid out white then black in EChessPieceType order
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "+Chess|Board", meta = (AllowPrivateAccess = "true"))
+	TArray<UInstancedStaticMeshComponent*> ChessPieceInstances;
+
 public:
 	AChessBoard();
 
 protected:
 	virtual void BeginPlay() override;
 
-public:
-	virtual void Tick(float DeltaTime) override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 #pragma region FUNCTIONS
 
@@ -40,14 +57,35 @@ public:
 
 	AChessPiece* SpawnChessPiece(FChessPieceInfo ChessPieceInfo);
 
+	// Draws a resting piece as an instance of its colour and type, reusing a slot another piece left
+	void AddChessPieceInstance(AChessPiece* ChessPiece);
+
+	// Frees the piece's slot, after this the piece is drawn by its own mesh or not at all
+	void RemoveChessPieceInstance(AChessPiece* ChessPiece);
+
+	// Pieces report their movement starting and stopping and the game mode its analysis, the only ticking a board does
+	void SetTicking(bool bTicking);
+
+	UFUNCTION(BlueprintPure, Category = "+Chess|Board")
+	FORCEINLINE int32 GetNumActiveTicks() const { return NumActiveTicks; }
+
+	// Brings AttackMap up to date with Position and mirrors the tiles whose attack status changed
 	void UpdateAttackStatusOfTiles();
 
+	UFUNCTION(BlueprintPure, Category = "+Chess|Board")
+	bool IsTileUnderAttack(int32 TileIndex, bool bByWhitePieces) const;
+
 	void ClearAllValidMoves();
 
 	UFUNCTION()
 	void GenerateAllValidMoves(bool bIsWhiteTurn);
 
-	bool HightlightValidMovesOnTile(bool bHighlight, FChessTileInfo ChessTileInfo);
+	bool HightlightValidMovesOnTile(bool bHighlight, const FChessTileInfo& ChessTileInfo);
+
+	// Applies the legal move between two tiles to Position, pieces mirror it afterwards
+	FChessMove ApplyMoveToPosition(int32 FromIndex, int32 ToIndex);
+
+	void PromotePieceOnPosition(int32 PositionIndex, EChessPieceType PromotionType);
 	
 	FORCEINLINE AChessTile* GetChessTileAtPosition(FVector2D Position) const
 	{
@@ -56,6 +94,12 @@ public:
 		return ChessTiles[(Position.X * 8 + Position.Y)];
 	}
 
+	// The tile a cursor trace hit, whether it hit a tile actor or one of the tile instances
+	AChessTile* GetChessTileFromHit(const FHitResult& HitResult) const;
+
+	// Goes through the tile instances when they draw the board, the tile's own material otherwise
+	void HighlightTile(int32 TileIndex, bool bHighlight);
+
 
 
 	// Enpassant Functions
@@ -66,8 +110,16 @@ public:
 
 
 
+	// Zobrist key of the current position, identical positions share a key whatever move order reached them
+	FORCEINLINE uint64 GetPositionKey() const { return Position.GetKey(); }
+
+	// Third occurrence of the current position with the same side to move, castling and en passant rights
+	bool IsThreefoldRepetition() const;
+
+
+
 	// Check Functions
-	bool IsKingInCheck(bool bIsWhiteKing, const TArray<FChessTileInfo>& BoardLayout, int32 OutEnpassantTarget) const;
+	FORCEINLINE bool IsKingInCheck(bool bIsWhiteKing) const { return Position.IsInCheck(EChessColour::FromIsWhite(bIsWhiteKing)); }
 
 
 
@@ -100,23 +152,30 @@ public:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "+Chess|Board", meta = (AllowedClasses = "/Script/CoreUObject.Class'/Script/Chess.ChessPiece'"))
 	TSubclassOf<AActor> ChessPieceClass = nullptr;
 
-	UPROPERTY(BlueprintReadOnly, Category = "+Chess|Board")
-	TArray<AChessPiece*> WhiteChessPieces;
+	// Draws the tiles as instances of one mesh instead of a mesh and material per tile actor, the tile actors stay as logical squares only
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "+Chess|Board|Rendering")
+	bool bUseInstancedTiles = false;
 
-	UPROPERTY(BlueprintReadOnly, Category = "+Chess|Board")
-	TArray<AChessPiece*> BlackChessPieces;
+	// Shared by every tile instance, each instance component passes its look through custom primitive data like a tile actor does
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "+Chess|Board|Rendering", meta = (EditCondition = "bUseInstancedTiles"))
+	UMaterialInterface* InstancedTileMaterial = nullptr;
 
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "+Chess|Board")
-	TArray<FChessTileInfo> ChessBoardLayout;
+	// Draws resting pieces as instances per colour and type, a piece actor only shows its own mesh while it moves.
+	// Every piece is still an AChessPiece actor with its root and mesh components, this saves the draws and ticks, not the actors
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "+Chess|Board|Rendering")
+	bool bUseInstancedPieces = false;
+
+	UPROPERTY(BlueprintAssignable, Category = "+Chess|Board")
+	FOnBoardPositionChanged OnPositionChanged;
 
 	UPROPERTY(BlueprintReadOnly, Category = "+Chess|Board")
-	TArray<FChessTileInfo> HighlightedTiles;
+	TArray<AChessPiece*> WhiteChessPieces;
 
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "+Chess|Board")
-	TArray<FChessTileInfo> ChessTilesUnderAttackByWhitePieces;
+	UPROPERTY(BlueprintReadOnly, Category = "+Chess|Board")
+	TArray<AChessPiece*> BlackChessPieces;
 
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "+Chess|Board")
-	TArray<FChessTileInfo> ChessTilesUnderAttackByBlackPieces;
+	// One bit per highlighted tile index
+	uint64 HighlightedTiles = 0;
 
 	UPROPERTY(BlueprintReadOnly, Category = "+Chess|Board")
 	TArray<FVector> ChessTileLocations;
@@ -124,6 +183,30 @@ public:
 	UPROPERTY(BlueprintReadOnly, Category = "+Chess|Board")
 	TArray<AChessTile*> ChessTiles;
 
+	FChessPosition Position;
+
+	FChessMoveList LegalMoves;
+
+	FChessAttackMap AttackMap;
+
+	// Key of every position reached this game, the current one last
+	TArray<uint64> PositionKeyHistory;
+
+private:
+	// Tiles last mirrored as attacked into FChessTileInfo, per colour
+	uint64 TilesUnderAttack[EChessColour::Num] = {};
+
+	// Hidden slots in ChessPieceInstances that the next piece of that colour and type can take
+	TArray<int32> FreeChessPieceInstances[EChessColour::Num * EChessPiece::Num];
+
+	// Pieces of this board whose movement is ticking right now, plus the game mode while it analyses this board
+	int32 NumActiveTicks = 0;
+
+	// "Active Ticks - <board name>" in stat Chess, one per board
+	TStatId ActiveTicksStatId;
+
+public:
+
 
 	// Check variables
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "+Chess|Board")
@@ -0,0 +1,152 @@
+// Copyright Kunal Patil (kroxyserver). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Ordering matches EChessPieceType so the two can be static_cast between each other
+namespace EChessPiece
+{
+	enum Type : uint8
+	{
+		King,
+		Queen,
+		Bishop,
+		Knight,
+		Rook,
+		Pawn,
+		Num,
+		None = Num
+	};
+}
+
+namespace EChessColour
+{
+	enum Type : uint8
+	{
+		White,
+		Black,
+		Num
+	};
+
+	FORCEINLINE Type GetOpposite(Type Colour) { return static_cast<Type>(Colour ^ 1); }
+
+	FORCEINLINE Type FromIsWhite(bool bIsWhite) { return bIsWhite ? White : Black; }
+}
+
+namespace EChessMoveFlag
+{
+	enum Type : uint8
+	{
+		Quiet					= 0,
+		DoublePawnPush			= 1,
+		KingCastle				= 2,
+		QueenCastle				= 3,
+		Capture					= 4,
+		EnPassant				= 5,
+		KnightPromotion			= 8,
+		BishopPromotion			= 9,
+		RookPromotion			= 10,
+		QueenPromotion			= 11,
+		KnightPromotionCapture	= 12,
+		BishopPromotionCapture	= 13,
+		RookPromotionCapture	= 14,
+		QueenPromotionCapture	= 15
+	};
+}
+
+// 16 bit move : 6 bits From square, 6 bits To square, 4 bits EChessMoveFlag
+struct FChessMove
+{
+	uint16 Data = 0;
+
+	FChessMove() = default;
+
+	FChessMove(int32 From, int32 To, EChessMoveFlag::Type Flag) :
+		Data(static_cast<uint16>(From | (To << 6) | (Flag << 12))) {}
+
+	FORCEINLINE int32 GetFrom() const { return Data & 0x3F; }
+
+	FORCEINLINE int32 GetTo() const { return (Data >> 6) & 0x3F; }
+
+	FORCEINLINE EChessMoveFlag::Type GetFlag() const { return static_cast<EChessMoveFlag::Type>(Data >> 12); }
+
+	FORCEINLINE bool IsValid() const { return Data != 0; }
+
+	FORCEINLINE bool IsCapture() const { return (GetFlag() & EChessMoveFlag::Capture) != 0; }
+
+	FORCEINLINE bool IsPromotion() const { return (GetFlag() & EChessMoveFlag::KnightPromotion) != 0; }
+
+	FORCEINLINE bool IsEnPassant() const { return GetFlag() == EChessMoveFlag::EnPassant; }
+
+	// Neither a capture nor a promotion, the moves killers and history apply to
+	FORCEINLINE bool IsQuiet() const { return !IsCapture() && !IsPromotion(); }
+
+	FORCEINLINE bool IsCastle() const { return GetFlag() == EChessMoveFlag::KingCastle || GetFlag() == EChessMoveFlag::QueenCastle; }
+
+	FORCEINLINE EChessPiece::Type GetPromotionPiece() const
+	{
+		static constexpr EChessPiece::Type PromotionPieces[4] = { EChessPiece::Knight, EChessPiece::Bishop, EChessPiece::Rook, EChessPiece::Queen };
+		return IsPromotion() ? PromotionPieces[GetFlag() & 3] : EChessPiece::None;
+	}
+
+	FORCEINLINE bool operator==(const FChessMove& Other) const { return Data == Other.Data; }
+	FORCEINLINE bool operator!=(const FChessMove& Other) const { return Data != Other.Data; }
+
+	// Long algebraic notation e.g. "e2e4" or "e7e8q"
+	FString ToString() const
+	{
+		if (!IsValid()) return TEXT("0000");
+
+		FString Result;
+		Result.AppendChar(TCHAR('a' + (GetFrom() & 7)));
+		Result.AppendChar(TCHAR('1' + (GetFrom() >> 3)));
+		Result.AppendChar(TCHAR('a' + (GetTo() & 7)));
+		Result.AppendChar(TCHAR('1' + (GetTo() >> 3)));
+
+		switch (GetPromotionPiece())
+		{
+		case EChessPiece::Queen:	Result.AppendChar(TCHAR('q')); break;
+		case EChessPiece::Rook:		Result.AppendChar(TCHAR('r')); break;
+		case EChessPiece::Bishop:	Result.AppendChar(TCHAR('b')); break;
+		case EChessPiece::Knight:	Result.AppendChar(TCHAR('n')); break;
+		default: break;
+		}
+
+		return Result;
+	}
+};
+
+// Fixed capacity move list so move generation never touches the heap
+struct FChessMoveList
+{
+	static constexpr int32 MaxMoves = 256;
+
+	FChessMove Moves[MaxMoves];
+
+	int32 Num = 0;
+
+	FORCEINLINE void Add(FChessMove Move)
+	{
+		checkSlow(Num < MaxMoves);
+		Moves[Num++] = Move;
+	}
+
+	FORCEINLINE void Reset() { Num = 0; }
+
+	FORCEINLINE bool Contains(FChessMove Move) const
+	{
+		for (int32 i = 0; i < Num; i++)
+			if (Moves[i] == Move) return true;
+
+		return false;
+	}
+
+	FORCEINLINE FChessMove& operator[](int32 Index) { return Moves[Index]; }
+	FORCEINLINE const FChessMove& operator[](int32 Index) const { return Moves[Index]; }
+
+	FORCEINLINE FChessMove* begin() { return Moves; }
+	FORCEINLINE FChessMove* end() { return Moves + Num; }
+	FORCEINLINE const FChessMove* begin() const { return Moves; }
+	FORCEINLINE const FChessMove* end() const { return Moves + Num; }
+};
@@ -0,0 +1,43 @@
+// Copyright Kunal Patil (kroxyserver). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Board/ChessMove.h"
+
+class FChessPosition;
+
+namespace EChessMoveGeneration
+{
+	enum Type : uint8
+	{
+		All,
+		// Captures, en passant and promotions
+		Captures,
+		// Everything else, castling included
+		Quiets
+	};
+}
+
+class CHESS_API FChessMoveGenerator
+{
+public:
+	// Emits only legal moves, checkers, pinned pieces and the evasion mask are worked out once up front
+	static void GenerateLegalMoves(const FChessPosition& Position, FChessMoveList& OutMoves);
+
+	// Legal captures, en passant and promotions only, for the quiescence search and the move picker
+	static void GenerateLegalCaptures(const FChessPosition& Position, FChessMoveList& OutMoves);
+
+	// The legal moves GenerateLegalCaptures leaves out
+	static void GenerateLegalQuiets(const FChessPosition& Position, FChessMoveList& OutMoves);
+
+	// Whether Move could have been generated here ignoring checks and pins, so moves from the transposition table or killer slots can be trusted
+	static bool IsPseudoLegal(const FChessPosition& Position, FChessMove Move);
+
+	// Make / unmake check for a single move, for moves that didn't come from GenerateLegalMoves
+	static bool IsLegal(FChessPosition& Position, FChessMove Move);
+
+private:
+	static void GenerateMoves(const FChessPosition& Position, EChessMoveGeneration::Type Generation, FChessMoveList& OutMoves);
+};
@@ -0,0 +1,39 @@
+// Copyright Kunal Patil (kroxyserver). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Board/ChessMove.h"
+
+class FChessPosition;
+
+struct FChessPerftCase
+{
+	const TCHAR* Name;
+
+	const TCHAR* Fen;
+
+	// Expected node counts, index 0 is depth 1
+	TArray<uint64> ExpectedNodes;
+};
+
+struct FChessPerftDivideEntry
+{
+	FChessMove Move;
+
+	uint64 Nodes = 0;
+};
+
+class CHESS_API FChessPerft
+{
+public:
+	// Counts leaf nodes of the legal move tree, Position is left unchanged
+	static uint64 Perft(FChessPosition& Position, int32 Depth);
+
+	// Perft split per root move
+	static uint64 Divide(FChessPosition& Position, int32 Depth, TArray<FChessPerftDivideEntry>& OutEntries);
+
+	// Start position plus the well known positions that cover castling, en passant, promotion and pins
+	static const TArray<FChessPerftCase>& GetStandardSuite();
+};
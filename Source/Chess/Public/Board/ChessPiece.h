@@ -5,16 +5,12 @@
 #include "CoreMinimal.h"
 
 #include "GameFramework/Actor.h"
-#include "Kismet/GameplayStaticsTypes.h"
 
 #include "ChessPiece.generated.h"
 
 class AChessBoard;
 class AChessTile;
 class UChessBoardData;
-struct FChessTileInfo;
-
-class UInterpToMovementComponent;
 
 UENUM(BlueprintType)
 enum class EChessPieceType : uint8
@@ -97,9 +93,6 @@ class CHESS_API AChessPiece : public AActor
 
 	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "+Chess|Piece", meta = (AllowPrivateAccess = "true"))
 	UStaticMeshComponent* ChessPieceMesh = nullptr;
-	
-	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly, Category = "+Chess|Piece", meta = (AllowPrivateAccess = "true"))
-	UInterpToMovementComponent* InterpToMovementComponent = nullptr;
 
 public:
 	AChessPiece();
@@ -107,12 +100,12 @@ public:
 	virtual void OnConstruction(const FTransform& Transform) override;
 
 	FORCEINLINE UStaticMeshComponent* GetChessPieceMesh() const { return ChessPieceMesh; }
-	FORCEINLINE UInterpToMovementComponent* GetInterpToMovementComponent() const { return InterpToMovementComponent; }
 
 protected:
 	virtual void BeginPlay() override;
 
-public:	
+public:
+	// Only enabled while the piece is moving along its arc
 	virtual void Tick(float DeltaTime) override;
 
 #pragma region FUNCTIONS
@@ -120,40 +113,30 @@ public:
 public:
 	void UpdateChessPieceStaticMesh();
 
-	TArray<FChessTileInfo> CalculateValidMoveTilesForKing(TArray<FChessTileInfo> Board);
-
-	TArray<FChessTileInfo> CalculateValidMoveTilesForQueen(TArray<FChessTileInfo> Board);
-
-	TArray<FChessTileInfo> CalculateValidMoveTilesForBishop(TArray<FChessTileInfo> Board);
-
-	TArray<FChessTileInfo> CalculateValidMoveTilesForKnight(TArray<FChessTileInfo> Board);
-
-	TArray<FChessTileInfo> CalculateValidMoveTilesForRook(TArray<FChessTileInfo> Board);
-
-	TArray<FChessTileInfo> CalculateValidMoveTilesForPawn(TArray<FChessTileInfo> Board, int32 OutEnpassantTarget);
-
 	void CapturePiece();
 
-	void CalculateValidMoves();
-
-	TArray<FChessTileInfo> FilterMovesForCheck(TArray<FChessTileInfo>& ValidMovesBeforeFilteration);
+	// bShowPromotionUI false leaves promotion to the caller, the AI already knows which piece it wants
+	void MovePiece(AChessTile* MoveToTile, bool bShowPromotionUI = true);
 
-	void SimulateMove(int32 ToPosition, TArray<FChessTileInfo>& BoardLayout, int32& OutEnPassantTarget, bool bIsWhiteTurn);
-
-	void MovePiece(AChessTile* MoveToTile);
+	UFUNCTION(BlueprintCallable, Category = "+Chess|Piece")
+	void PromotePawn(EChessPieceType PromotionType);
 
-	void UpdateTilesUnderAttack(TArray<FChessTileInfo>& TilesUnderAttack);
+private:
+	// Hands the piece back to the board's instances once it lands
+	void OnMovementFinished();
 
-	FORCEINLINE bool IsPositionWithinBounds(FVector2D Position) { return Position.X >= 0 && Position.X < 8 && Position.Y >= 0 && Position.Y < 8; }
+	// A piece only ticks for the length of a move
+	void SetMovementTickEnabled(bool bEnabled);
 
-	UFUNCTION(BlueprintCallable, Category = "+Chess|Piece")
-	void PromotePawn(EChessPieceType PromotionType);
+	// Point on the parabola from ArcStart to ArcEnd, Alpha 0 to 1 across its span
+	FORCEINLINE FVector EvaluateArc(float Alpha) const { return FMath::Lerp(ArcStart, ArcEnd, Alpha) + FVector::UpVector * (4.f * ArcHeight * Alpha * (1.f - Alpha)); }
 
 #pragma endregion
 
 #pragma region VARIABLES
 
 public:
+	// Length of the arc the piece is moving along
 	float TotalTravelDistance = 0.f;
 
 	FOnPieceCaptured OnPieceCaptured;
@@ -164,24 +147,32 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "+Chess|Piece")
 	FChessPieceInfo ChessPieceInfo;
 
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "+Chess|Piece")
-	TArray<FChessTileInfo> ValidMoves;
+	// Destination tiles of this piece's legal moves, one bit per tile index
+	uint64 ValidMoves = 0;
 
 	UPROPERTY(BlueprintReadOnly, Category = "+Chess|Piece")
 	AChessBoard* ChessBoard = nullptr;
 
+	// Set before spawning finishes when the board draws this piece as an instance, the actor only shows its own mesh while it moves.
+	// The actor and its components still exist while resting, only their draw and tick are gone
+	bool bRenderedByBoard = false;
+
+	// Slot in the board's instances for this piece's type and colour, INDEX_NONE while the actor draws the piece itself
+	int32 ChessPieceInstanceIndex = INDEX_NONE;
+
 private:
-	FPredictProjectilePathParams PredictParams;
-	
-	TArray<FVector2D> KingMovePositionTileOffsets = { FVector2D(1, -1), FVector2D(1, 0), FVector2D(1, 1), FVector2D(0, 1), FVector2D(-1, 1), FVector2D(-1, 0), FVector2D(-1, -1), FVector2D(0, -1) };
+	static constexpr int32 NumArcSamples = 32;
 
-	TArray<FVector2D> KnightMovePositionTileOffsets = { FVector2D(2, -1), FVector2D(2, 1), FVector2D(1, 2), FVector2D(-1, 2), FVector2D(-2, 1), FVector2D(-2, -1), FVector2D(-1, -2), FVector2D(1, -2) };
+	FVector ArcStart = FVector::ZeroVector;
 
-	TArray<FVector2D> BishopMovePositionDirections = { FVector2D(1, -1), FVector2D(1, 1), FVector2D(-1, 1), FVector2D(-1, -1) };
+	FVector ArcEnd = FVector::ZeroVector;
 
-	TArray<FVector2D> RookMovePositionDirections = { FVector2D(1, 0), FVector2D(0, 1), FVector2D(-1, 0), FVector2D(0, -1) };
+	float ArcHeight = 0.f;
 
-	TArray<FVector2D> QueenMovePositionDirections = KingMovePositionTileOffsets;
+	// Arc length up to each evenly spaced sample, filled once per move so the piece travels the arc at a steady speed
+	float ArcLengths[NumArcSamples + 1] = {};
 
+	float ArcDistanceTravelled = 0.f;
+	
 #pragma endregion
 };
\ No newline at end of file
@@ -0,0 +1,30 @@
+// Copyright Kunal Patil (kroxyserver). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Board/ChessMove.h"
+
+// Material plus piece-square bonus for every piece on every square, in middlegame and endgame flavours
+// Values are from white's point of view so FChessPosition can keep a running total the same way it keeps its Zobrist key
+namespace ChessPieceSquare
+{
+	namespace Tables
+	{
+		extern CHESS_API int16 Middlegame[EChessColour::Num][EChessPiece::Num][64];
+		extern CHESS_API int16 Endgame[EChessColour::Num][EChessPiece::Num][64];
+	}
+
+	// Game phase contributed by each piece, a full set of minor and major pieces adds up to MaxPhase
+	constexpr int32 PhaseWeights[EChessPiece::Num] = { 0, 4, 1, 1, 2, 0 };
+
+	constexpr int32 MaxPhase = 24;
+
+	// Fills the tables, called once from FChessModule::StartupModule
+	CHESS_API void InitializeTables();
+
+	FORCEINLINE int32 GetMiddlegame(EChessColour::Type Colour, EChessPiece::Type Piece, int32 Square) { return Tables::Middlegame[Colour][Piece][Square]; }
+
+	FORCEINLINE int32 GetEndgame(EChessColour::Type Colour, EChessPiece::Type Piece, int32 Square) { return Tables::Endgame[Colour][Piece][Square]; }
+}
@@ -0,0 +1,184 @@
+// Copyright Kunal Patil (kroxyserver). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Board/ChessBitboard.h"
+#include "Board/ChessMove.h"
+#include "Board/ChessPieceSquareTables.h"
+#include "Board/ChessZobrist.h"
+
+namespace EChessCastlingRights
+{
+	enum Type : uint8
+	{
+		None			= 0,
+		WhiteKingSide	= 1 << 0,
+		WhiteQueenSide	= 1 << 1,
+		BlackKingSide	= 1 << 2,
+		BlackQueenSide	= 1 << 3,
+		All				= WhiteKingSide | WhiteQueenSide | BlackKingSide | BlackQueenSide
+	};
+}
+
+// One byte per square : colour in bit 3, EChessPiece in the low 3 bits, so the whole board fits in a single cache line
+namespace ChessMailbox
+{
+	constexpr uint8 Empty = EChessPiece::None;
+
+	FORCEINLINE constexpr uint8 MakeCode(EChessColour::Type Colour, EChessPiece::Type Piece) { return static_cast<uint8>((Colour << 3) | Piece); }
+
+	FORCEINLINE constexpr EChessColour::Type GetColour(uint8 Code) { return static_cast<EChessColour::Type>(Code >> 3); }
+
+	FORCEINLINE constexpr EChessPiece::Type GetPiece(uint8 Code) { return static_cast<EChessPiece::Type>(Code & 7); }
+}
+
+// Everything MakeMove can't recover from the move itself
+struct FChessUndoInfo
+{
+	EChessPiece::Type CapturedPiece = EChessPiece::None;
+
+	uint8 CastlingRights = 0;
+
+	int8 EnPassantSquare = -1;
+
+	uint16 HalfmoveClock = 0;
+
+	uint64 Key = 0;
+};
+
+// Plain bitboard position, the source of truth for move generation. Actors only mirror it for rendering.
+class CHESS_API FChessPosition
+{
+public:
+	FChessPosition();
+
+#pragma region FUNCTIONS
+
+public:
+	void Clear();
+
+	void SetStartingPosition();
+
+	bool SetFromFen(const FString& Fen);
+
+	FString ToFen() const;
+
+	void AddPiece(EChessColour::Type Colour, EChessPiece::Type Piece, int32 Square);
+
+	void RemovePiece(EChessColour::Type Colour, EChessPiece::Type Piece, int32 Square);
+
+	void MovePiece(EChessColour::Type Colour, EChessPiece::Type Piece, int32 From, int32 To);
+
+	FORCEINLINE bool GetPieceOnSquare(int32 Square, EChessColour::Type& OutColour, EChessPiece::Type& OutPiece) const
+	{
+		const uint8 Code = Mailbox[Square];
+		if (Code == ChessMailbox::Empty) return false;
+
+		OutColour = ChessMailbox::GetColour(Code);
+		OutPiece = ChessMailbox::GetPiece(Code);
+		return true;
+	}
+
+	FORCEINLINE EChessPiece::Type GetPieceTypeOnSquare(int32 Square) const { return ChessMailbox::GetPiece(Mailbox[Square]); }
+
+	FORCEINLINE const uint8* GetMailbox() const { return Mailbox; }
+
+	// Applies a move generated for this position, Undo receives what UnmakeMove needs to take it back
+	void MakeMove(FChessMove Move, FChessUndoInfo& OutUndo);
+
+	void UnmakeMove(FChessMove Move, const FChessUndoInfo& Undo);
+
+	FORCEINLINE void ApplyMove(FChessMove Move)
+	{
+		FChessUndoInfo Undo;
+		MakeMove(Move, Undo);
+	}
+
+	uint64 GetAttackersTo(int32 Square, uint64 Occupied) const;
+
+	bool IsSquareAttacked(int32 Square, EChessColour::Type ByColour) const;
+
+	FORCEINLINE bool IsInCheck(EChessColour::Type Colour) const { return IsSquareAttacked(GetKingSquare(Colour), EChessColour::GetOpposite(Colour)); }
+
+	FORCEINLINE bool IsInCheck() const { return IsInCheck(SideToMove); }
+
+	FORCEINLINE uint64 GetPieces(EChessColour::Type Colour, EChessPiece::Type Piece) const { return PieceBitboards[Colour][Piece]; }
+
+	FORCEINLINE uint64 GetPieces(EChessColour::Type Colour) const { return ColourBitboards[Colour]; }
+
+	FORCEINLINE uint64 GetPieces(EChessPiece::Type Piece) const { return PieceBitboards[EChessColour::White][Piece] | PieceBitboards[EChessColour::Black][Piece]; }
+
+	FORCEINLINE uint64 GetOccupied() const { return OccupiedBitboard; }
+
+	FORCEINLINE int32 GetKingSquare(EChessColour::Type Colour) const { return ChessBitboard::GetLeastSignificantSquare(PieceBitboards[Colour][EChessPiece::King]); }
+
+	FORCEINLINE EChessColour::Type GetSideToMove() const { return SideToMove; }
+
+	void SetSideToMove(EChessColour::Type Colour);
+
+	FORCEINLINE uint8 GetCastlingRights() const { return CastlingRights; }
+
+	void SetCastlingRights(uint8 Rights);
+
+	FORCEINLINE bool HasCastlingRight(EChessCastlingRights::Type Right) const { return (CastlingRights & Right) != 0; }
+
+	FORCEINLINE int32 GetEnPassantSquare() const { return EnPassantSquare; }
+
+	FORCEINLINE int32 GetHalfmoveClock() const { return HalfmoveClock; }
+
+	FORCEINLINE int32 GetFullmoveNumber() const { return FullmoveNumber; }
+
+	// Zobrist key, kept up to date incrementally by every function that changes the position
+	FORCEINLINE uint64 GetKey() const { return Key; }
+
+	// Material plus piece-square totals from white's point of view, kept up to date alongside the key
+	FORCEINLINE int32 GetMiddlegameScore() const { return MiddlegameScore; }
+
+	FORCEINLINE int32 GetEndgameScore() const { return EndgameScore; }
+
+	// Sum of ChessPieceSquare::PhaseWeights over the board, can exceed MaxPhase after promotions
+	FORCEINLINE int32 GetPhase() const { return Phase; }
+
+	// Full recomputation of the key, only for verifying the incremental one
+	uint64 ComputeKey() const;
+
+private:
+	// En passant only changes the key when the side to move actually has a pawn that can take, otherwise identical positions would hash differently
+	uint64 GetEnPassantKey() const;
+
+#pragma endregion
+
+#pragma region VARIABLES
+
+private:
+	uint64 PieceBitboards[EChessColour::Num][EChessPiece::Num];
+
+	uint64 ColourBitboards[EChessColour::Num];
+
+	uint64 OccupiedBitboard;
+
+	// Kept in step with the bitboards, answers "what is on this square" without scanning twelve bitboards
+	uint8 Mailbox[64];
+
+	EChessColour::Type SideToMove;
+
+	uint8 CastlingRights;
+
+	int8 EnPassantSquare;
+
+	uint16 HalfmoveClock;
+
+	uint16 FullmoveNumber;
+
+	uint64 Key;
+
+	int32 MiddlegameScore;
+
+	int32 EndgameScore;
+
+	int32 Phase;
+
+#pragma endregion
+};
@@ -11,6 +11,19 @@
 class AChessBoard;
 class AChessPiece;
 
+// Custom primitive data floats of a tile mesh, M_ChessTile reads them as its Colour parameter
+namespace EChessTileCustomData
+{
+	enum Type : int32
+	{
+		Red,
+		Green,
+		Blue,
+		Highlight,
+		Num
+	};
+}
+
 USTRUCT(BlueprintType)
 struct FChessTileInfo
 {
@@ -75,25 +88,27 @@ protected:
 	virtual void BeginPlay() override;
 
 public:
-	virtual void Tick(float DeltaTime) override;
-
 #pragma region FUNCTIONS
 
 	void HighlightTile(bool bHighlight);
 
+	// Highlighted tiles are coloured here rather than in the material, which only passes Colour through
+	static FVector4 GetCustomData(bool bIsWhite, bool bIsHighlighted);
+
 #pragma endregion
 
 #pragma region VARIABLES
 
 public:
+	// Shared by every tile so they batch, has to read custom primitive data in EChessTileCustomData order
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "+Chess|Tile")
 	UMaterialInterface* TileMaterial = nullptr;
 
-	UPROPERTY(BlueprintReadOnly, Category = "+Chess|Tile")
-	UMaterialInstanceDynamic* TileMaterialInstanceDynamic = nullptr;
-
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "+Chess|Tile")
 	FChessTileInfo ChessTileInfo;
 
+	// Set before spawning finishes when the board draws this tile as an instance, the actor then only holds the square's state
+	bool bRenderedByBoard = false;
+
 #pragma endregion
 };
\ No newline at end of file
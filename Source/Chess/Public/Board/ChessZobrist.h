@@ -0,0 +1,30 @@
+// Copyright Kunal Patil (kroxyserver). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Board/ChessMove.h"
+
+// Random keys XORed together to identify a position, FChessPosition keeps its key up to date on every change
+namespace ChessZobrist
+{
+	namespace Keys
+	{
+		extern CHESS_API uint64 Pieces[EChessColour::Num][EChessPiece::Num][64];
+		extern CHESS_API uint64 Castling[16];
+		extern CHESS_API uint64 EnPassantFile[8];
+		extern CHESS_API uint64 BlackToMove;
+	}
+
+	// Fills the key tables from a fixed seed, called once from FChessModule::StartupModule
+	CHESS_API void InitializeKeys();
+
+	FORCEINLINE uint64 GetPieceKey(EChessColour::Type Colour, EChessPiece::Type Piece, int32 Square) { return Keys::Pieces[Colour][Piece][Square]; }
+
+	FORCEINLINE uint64 GetCastlingKey(uint8 CastlingRights) { return Keys::Castling[CastlingRights]; }
+
+	FORCEINLINE uint64 GetEnPassantKey(int32 Square) { return Keys::EnPassantFile[Square & 7]; }
+
+	FORCEINLINE uint64 GetBlackToMoveKey() { return Keys::BlackToMove; }
+}
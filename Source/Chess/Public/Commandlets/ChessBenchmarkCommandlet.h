@@ -0,0 +1,40 @@
+// Copyright Kunal Patil (kroxyserver). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Commandlets/Commandlet.h"
+
+#include "ChessBenchmarkCommandlet.generated.h"
+
+struct FChessSearchResult;
+
+/**
+ * Benchmarks the AI over a fixed set of positions
+ * UnrealEditor-Cmd.exe Chess.uproject -run=ChessBenchmark [-Mode=Search|Evaluation]
+ * Search : [-Depth=N] [-Threads=N] [-HashMB=N], searched once on a single thread and once on N threads, the table is cleared before every position
+ * Evaluation : [-Seconds=N] [-Network=Path], hand crafted against network evaluations per second over every position two plies from the set
+ */
+UCLASS()
+class CHESS_API UChessBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UChessBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+#pragma region FUNCTIONS
+
+private:
+	int32 RunSearchBenchmark(const FString& Params) const;
+
+	int32 RunEvaluationBenchmark(const FString& Params) const;
+
+	// Searches every benchmark position and returns the total, Seconds is the time to reach Depth summed over positions
+	FChessSearchResult SearchBenchmarkPositions(int32 Depth, int32 NumThreads, int32 HashSizeMB) const;
+
+#pragma endregion
+};
@@ -0,0 +1,34 @@
+// Copyright Kunal Patil (kroxyserver). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Commandlets/Commandlet.h"
+
+#include "ChessPerftCommandlet.generated.h"
+
+class FChessPosition;
+
+/**
+ * Runs perft over the move generator and reports node counts and nodes per second
+ * UnrealEditor-Cmd.exe Chess.uproject -run=ChessPerft [-Depth=N] [-Fen="..."] [-Divide]
+ * Without -Fen the standard suite is checked against the known counts and a mismatch makes the commandlet return 1
+ */
+UCLASS()
+class CHESS_API UChessPerftCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UChessPerftCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+#pragma region FUNCTIONS
+
+private:
+	uint64 RunPerft(FChessPosition& Position, int32 Depth, bool bDivide, double& OutSeconds) const;
+
+#pragma endregion
+};
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 
+#include "Board/ChessMove.h"
 #include "Core/ChessGameInstance.h"
 
 #include "GameFramework/GameMode.h"
@@ -11,10 +12,48 @@
 #include "ChessGameMode.generated.h"
 
 class AChessBoard;
+class FChessAnalysis;
+class FChessAsyncSearch;
+class FChessNeuralNetwork;
+class FChessOpeningBook;
+class FChessTranspositionTable;
 class AChessPlayer;
 class AChessPlayerController;
 class AChessTile;
 
+struct FChessSearchLimits;
+struct FChessSearchResult;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnAISearchProgress, int32, Depth, int32, Score);
+
+USTRUCT(BlueprintType)
+struct FChessAnalysisLine
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly)
+    int32 Depth;
+
+    // Centipawns from white's point of view
+    UPROPERTY(BlueprintReadOnly)
+    int32 Score;
+
+    // Moves until mate, negative when black mates, 0 when no mate was found
+    UPROPERTY(BlueprintReadOnly)
+    int32 MateIn;
+
+    // Long algebraic notation separated by spaces, e.g. "e2e4 e7e5 g1f3"
+    UPROPERTY(BlueprintReadOnly)
+    FString Moves;
+
+    FChessAnalysisLine() :
+        Depth(0),
+        Score(0),
+        MateIn(0) {}
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnAnalysisUpdated, const TArray<FChessAnalysisLine>&, Lines);
+
 UCLASS()
 class CHESS_API AChessGameMode : public AGameMode
 {
@@ -25,14 +64,65 @@ public:
 
     virtual void OnConstruction(const FTransform& Transform) override;
 
+    virtual void Tick(float DeltaSeconds) override;
+
 protected:
     virtual void BeginPlay() override;
 
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 #pragma region FUNCTION
 
 public:
     void SwitchTurn();
 
+    // Starts a background search of the current position, the AI moves once it completes
+    void PlayAITurn();
+
+    void OnAISearchProgress(const FChessSearchResult& Result);
+
+    void OnAISearchComplete(const FChessSearchResult& Result);
+
+    // Plays a move for the AI through the same path SelectPiece uses
+    void ApplyAIMove(FChessMove Move);
+
+    // Searches the board position without end, streaming the best AnalysisLines lines through OnAnalysisUpdated. Follows the board as moves are played
+    UFUNCTION(BlueprintCallable, Category = "+Chess|GameMode|Analysis")
+    void StartAnalysis();
+
+    UFUNCTION(BlueprintCallable, Category = "+Chess|GameMode|Analysis")
+    void StopAnalysis();
+
+    UFUNCTION(BlueprintPure, Category = "+Chess|GameMode|Analysis")
+    bool IsAnalysing() const;
+
+private:
+    // Loads the network named in the board data, the AI falls back to the hand crafted evaluation without one
+    void LoadAINeuralNetwork();
+
+    // Maps the board data's Polyglot book, the AI searches every move without one
+    void LoadAIOpeningBook();
+
+    // Plays a book move straight away while the game is within MaxBookDepth, false once out of book
+    bool TryPlayAIBookMove();
+
+    // Settings and the AI's clock turned into limits for one search
+    FChessSearchLimits MakeAISearchLimits() const;
+
+    // Searches the position after the reply the AI expects while the player is still choosing their move
+    void StartAIPonder();
+
+    // On a ponder hit the pondering search becomes this turn's search, false on a miss or when there was nothing to ponder
+    bool TryContinueAIPonder();
+
+    void OnAIPonderProgress(const FChessSearchResult& Result);
+
+    void OnAIPonderComplete(const FChessSearchResult& Result);
+
+    // Moves and promotions both leave the analysed position behind, so the analysis starts over on the new one. A promotion also lets a waiting AI turn begin
+    UFUNCTION()
+    void OnBoardPositionChanged();
+
 #pragma endregion
 
 #pragma region VARIABLES
@@ -56,5 +146,53 @@ public:
     UPROPERTY(BlueprintReadOnly, Category = "+Chess|GameMode")
     bool bIsWhiteTurn;
 
+    // A pawn reached the last rank and the promotion UI hasn't picked its piece yet. Position still holds the default queen, so the AI waits
+    UPROPERTY(BlueprintReadOnly, Category = "+Chess|GameMode")
+    bool bIsAwaitingPromotion = false;
+
+    // Fires on the game thread after every completed search depth while the AI is thinking
+    UPROPERTY(BlueprintAssignable, Category = "+Chess|GameMode")
+    FOnAISearchProgress OnAISearchProgressUpdated;
+
+    // Fires at most once a frame while analysing, with the lines best first
+    UPROPERTY(BlueprintAssignable, Category = "+Chess|GameMode|Analysis")
+    FOnAnalysisUpdated OnAnalysisUpdated;
+
+private:
+    TSharedPtr<FChessAsyncSearch, ESPMode::ThreadSafe> AISearch;
+
+    TSharedPtr<FChessTranspositionTable, ESPMode::ThreadSafe> AITranspositionTable;
+
+    // Null when the board data names no network or it fails to load
+    TSharedPtr<const FChessNeuralNetwork, ESPMode::ThreadSafe> AINeuralNetwork;
+
+    // Only read on the game thread, null when the board data names no book or it fails to open
+    TSharedPtr<FChessOpeningBook> AIOpeningBook;
+
+    // Picks between weighted book moves so the AI doesn't always open the same way
+    FRandomStream AIBookRandom;
+
+    // Seconds left on the AI's clock, unused when the settings give no ClockTime
+    double AIClockSeconds = 0.0;
+
+    // When the AI's current turn began, its clock runs from here
+    double AITurnStartTime = 0.0;
+
+    TSharedPtr<FChessAsyncSearch, ESPMode::ThreadSafe> AIPonderSearch;
+
+    // Second move of the AI's last principal variation, the reply it ponders on
+    FChessMove AIPonderMove;
+
+    // Key of the position being pondered, the player's move was the expected one if the board reaches it
+    uint64 AIPonderKey = 0;
+
+    bool bAIPonderHit = false;
+
+    // Set when the pondering search ran out of depth before the player moved
+    TSharedPtr<FChessSearchResult> AIPonderResult;
+
+    // Null unless analysing, only drained in Tick
+    TSharedPtr<FChessAnalysis, ESPMode::ThreadSafe> Analysis;
+
 #pragma endregion
 };
\ No newline at end of file
@@ -34,6 +34,9 @@ protected:
 public:
     void SelectPiece();
 
+    // Shared by SelectPiece and the AI : captures whatever is on ToTile, moves the piece and hands the turn over. False leaves the board and the turn untouched when Position has no such move
+    bool MovePieceToTile(AChessTile* FromTile, AChessTile* ToTile, bool bShowPromotionUI = true);
+
     UFUNCTION(BlueprintImplementableEvent, Category = "+Chess|PlayerController")
     void SpawnPawnPromotionUI(AChessPiece* PawnPiece);
 
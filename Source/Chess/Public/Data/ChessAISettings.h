@@ -0,0 +1,58 @@
+// Copyright Kunal Patil (kroxyserver). All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Engine/DeveloperSettings.h"
+
+#include "ChessAISettings.generated.h"
+
+UCLASS(config = Game, defaultconfig, meta = (DisplayName = "Chess AI"))
+class CHESS_API UChessAISettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	UChessAISettings();
+
+#pragma region VARIABLES
+
+public:
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "+Chess|AI|Search", meta = (ClampMin = "1", ClampMax = "63"))
+	int32 MaxSearchDepth;
+
+	// Seconds the AI may think per move, 0 searches to MaxSearchDepth regardless of time. On a clock it caps each move's budget
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "+Chess|AI|Search", meta = (ClampMin = "0.0", Units = "s"))
+	float MaxThinkTime;
+
+	// Shared by every search thread and kept between moves, rounded down to a power of two
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "+Chess|AI|Search", meta = (ClampMin = "1", ClampMax = "65536", Units = "MB"))
+	int32 TranspositionTableSizeMB;
+
+	// Lazy SMP search threads, 0 uses every core but the one the game thread runs on
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "+Chess|AI|Search", meta = (ClampMin = "0", ClampMax = "256"))
+	int32 SearchThreads;
+
+	// Starting time on the AI's clock, the time manager budgets every move from what is left. 0 plays without a clock
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "+Chess|AI|Time", meta = (ClampMin = "0.0", Units = "s"))
+	float ClockTime;
+
+	// Added to the AI's clock after each of its moves
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "+Chess|AI|Time", meta = (ClampMin = "0.0", Units = "s"))
+	float ClockIncrement;
+
+	// Search the reply the AI expects while the player is still choosing, so a correct guess starts its turn with that work done
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "+Chess|AI|Time")
+	bool bPonder;
+
+	// Best lines the analysis view shows, each extra line costs about as much search as the first
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "+Chess|AI|Analysis", meta = (ClampMin = "1", ClampMax = "16"))
+	int32 AnalysisLines;
+
+	// Plies from the start of the game the AI looks moves up in the opening book for, 0 never uses the book
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "+Chess|AI|Book", meta = (ClampMin = "0", ClampMax = "255"))
+	int32 MaxBookDepth;
+
+#pragma endregion
+};
@@ -5,17 +5,23 @@
 #include "CoreMinimal.h"
 
 #include "Engine/DataAsset.h"
+#include "Engine/EngineTypes.h"
 
 #include "ChessBoardData.generated.h"
 
 struct FChessPieceInfo;
 
+enum class EChessPieceType : uint8;
+
 UCLASS()
 class CHESS_API UChessBoardData : public UDataAsset
 {
 	GENERATED_BODY()
 
 public:
+	// Null when the data asset leaves that piece's mesh unset
+	UStaticMesh* GetChessPieceMesh(bool bIsWhite, EChessPieceType ChessPieceType) const;
+
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "+Chess|Mesh|WhitePieces")
 	UStaticMesh* WhiteKing;
 
@@ -57,4 +63,16 @@ public:
 
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "+Chess|BlackPieces")
 	TArray<FChessPieceInfo> BlackChessPiecesInfo;
+
+	// Weights for the AI's neural network evaluation, relative to the project directory. Empty uses the hand crafted evaluation
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "+Chess|AI", meta = (FilePathFilter = "nnue", RelativeToGameDir))
+	FFilePath NeuralNetworkFile;
+
+	// Polyglot opening book the AI plays from before it starts searching, relative to the project directory. Empty disables the book
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "+Chess|AI", meta = (FilePathFilter = "bin", RelativeToGameDir))
+	FFilePath OpeningBookFile;
+
+	// Polyglot's 781 Random64 hash keys as big endian uint64, required alongside OpeningBookFile
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "+Chess|AI", meta = (FilePathFilter = "bin", RelativeToGameDir))
+	FFilePath OpeningBookKeysFile;
 };
\ No newline at end of file